@@ -0,0 +1,107 @@
+#include <zero/async/promise.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+    void resolveThen(benchmark::State &state) {
+        const auto executor = zero::async::promise::InlineExecutor::instance();
+
+        for (auto _: state) {
+            auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+
+            auto result = std::move(future).then([](const int value) {
+                return value + 1;
+            });
+
+            promise.resolve(1);
+            benchmark::DoNotOptimize(std::move(result).get());
+        }
+    }
+
+    void thenChain(benchmark::State &state) {
+        const auto length = state.range(0);
+
+        for (auto _: state) {
+            auto future = zero::async::promise::Future<int, std::error_code>::resolved(0);
+
+            for (std::int64_t i{0}; i < length; ++i)
+                future = std::move(future).then([](const int value) {
+                    return value + 1;
+                });
+
+            benchmark::DoNotOptimize(std::move(future).get());
+        }
+
+        state.SetItemsProcessed(state.iterations() * length);
+    }
+
+    void threadPoolHop(benchmark::State &state) {
+        const auto executor = std::make_shared<zero::async::promise::ThreadPoolExecutor>(
+            static_cast<std::size_t>(state.range(0))
+        );
+
+        for (auto _: state) {
+            auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+
+            auto result = std::move(future).then([](const int value) {
+                return value + 1;
+            });
+
+            promise.resolve(1);
+            benchmark::DoNotOptimize(std::move(result).get());
+        }
+    }
+
+    void allFanIn(benchmark::State &state) {
+        const auto executor = zero::async::promise::InlineExecutor::instance();
+        const auto n = static_cast<std::size_t>(state.range(0));
+
+        for (auto _: state) {
+            std::vector<zero::async::promise::Promise<int, std::error_code>> promises(n);
+            std::vector<zero::async::promise::Future<int, std::error_code>> futures;
+
+            futures.reserve(n);
+
+            for (auto &promise: promises)
+                futures.push_back(promise.getFuture().via(executor));
+
+            auto future = zero::async::promise::all(std::move(futures));
+
+            for (std::size_t i{0}; i < n; ++i)
+                promises[i].resolve(static_cast<int>(i));
+
+            benchmark::DoNotOptimize(std::move(future).get());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void gatherFanIn(benchmark::State &state) {
+        const auto executor = zero::async::promise::InlineExecutor::instance();
+        const auto n = static_cast<std::size_t>(state.range(0));
+
+        for (auto _: state) {
+            std::vector<zero::async::promise::Promise<int, std::error_code>> promises(n);
+            std::vector<zero::async::promise::Future<int, std::error_code>> futures;
+
+            futures.reserve(n);
+
+            for (auto &promise: promises)
+                futures.push_back(promise.getFuture().via(executor));
+
+            auto future = zero::async::promise::gather(std::move(futures));
+
+            for (std::size_t i{0}; i < n; ++i)
+                promises[i].resolve(static_cast<int>(i));
+
+            benchmark::DoNotOptimize(std::move(future).get());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(resolveThen);
+BENCHMARK(thenChain)->Arg(16)->Arg(256);
+BENCHMARK(threadPoolHop)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(allFanIn)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(gatherFanIn)->RangeMultiplier(8)->Range(8, 4096);
@@ -0,0 +1,46 @@
+#include <zero/atomic/event.h>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+namespace {
+    void setWait(benchmark::State &state) {
+        zero::atomic::Event event;
+
+        for (auto _: state) {
+            event.set();
+            benchmark::DoNotOptimize(event.wait());
+        }
+    }
+
+    // Two threads hand control back and forth, so every iteration includes two wake-ups.
+    void pingPong(benchmark::State &state) {
+        zero::atomic::Event ping;
+        zero::atomic::Event pong;
+        std::atomic<bool> stop{false};
+
+        std::thread thread{
+            [&] {
+                while (true) {
+                    std::ignore = ping.wait();
+
+                    if (stop)
+                        break;
+
+                    pong.set();
+                }
+            }
+        };
+
+        for (auto _: state) {
+            ping.set();
+            std::ignore = pong.wait();
+        }
+
+        stop = true;
+        ping.set();
+        thread.join();
+    }
+}
+
+BENCHMARK(setWait);
+BENCHMARK(pingPong)->UseRealTime();
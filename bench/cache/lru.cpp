@@ -0,0 +1,33 @@
+#include <zero/cache/lru.h>
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace {
+    // The first argument is the capacity, the second the percentage of operations that are reads. Keys are drawn from
+    // twice the capacity, so roughly half of the reads miss and half of the writes evict.
+    void getSet(benchmark::State &state) {
+        const auto capacity = static_cast<std::size_t>(state.range(0));
+        const auto reads = state.range(1);
+
+        zero::cache::LRUCache<std::size_t, std::size_t> cache{capacity};
+        std::minstd_rand engine{0};
+        std::uniform_int_distribution<std::size_t> keys{0, capacity * 2 - 1};
+        std::uniform_int_distribution<std::int64_t> operations{0, 99};
+
+        for (std::size_t i{0}; i < capacity; ++i)
+            cache.set(i, std::size_t{i});
+
+        for (auto _: state) {
+            const auto key = keys(engine);
+
+            if (operations(engine) < reads) {
+                benchmark::DoNotOptimize(cache.get(key));
+                continue;
+            }
+
+            cache.set(key, std::size_t{key});
+        }
+    }
+}
+
+BENCHMARK(getSet)->ArgsProduct({{64, 4096, 262144}, {50, 90}});
@@ -0,0 +1,166 @@
+#include <zero/concurrent/channel.h>
+#include <benchmark/benchmark.h>
+#include <span>
+#include <thread>
+#include <algorithm>
+
+namespace {
+    constexpr std::size_t Messages = 100000;
+
+    // Every producer sends its share of the messages while the consumers drain the channel until it is closed.
+    void transfer(benchmark::State &state, const std::size_t producers, const std::size_t consumers) {
+        const auto capacity = static_cast<std::size_t>(state.range(0));
+
+        for (auto _: state) {
+            std::vector<std::thread> threads;
+
+            // the threads hold the only copies once this scope exits, so the channel closes with the last producer
+            {
+                auto [sender, receiver] = zero::concurrent::channel<std::size_t>(capacity);
+
+                for (std::size_t i{0}; i < consumers; ++i)
+                    threads.emplace_back([=] mutable {
+                        while (true) {
+                            const auto value = receiver.receive();
+
+                            if (!value)
+                                break;
+
+                            benchmark::DoNotOptimize(*value);
+                        }
+                    });
+
+                for (std::size_t i{0}; i < producers; ++i)
+                    threads.emplace_back([=] mutable {
+                        for (std::size_t j{0}; j < Messages / producers; ++j)
+                            std::ignore = sender.send(j);
+                    });
+            }
+
+            for (auto &thread: threads)
+                thread.join();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (Messages / producers * producers)));
+    }
+
+    // Same as `transfer`, but elements move in batches of up to 64 through `sendMany` / `receiveMany`.
+    void transferBatch(benchmark::State &state, const std::size_t producers, const std::size_t consumers) {
+        constexpr std::size_t Batch = 64;
+        const auto capacity = static_cast<std::size_t>(state.range(0));
+
+        for (auto _: state) {
+            std::vector<std::thread> threads;
+
+            {
+                auto [sender, receiver] = zero::concurrent::channel<std::size_t>(capacity);
+
+                for (std::size_t i{0}; i < consumers; ++i)
+                    threads.emplace_back([=] mutable {
+                        std::vector<std::size_t> values;
+                        values.reserve(Batch);
+
+                        while (true) {
+                            values.clear();
+
+                            if (!receiver.receiveMany(std::back_inserter(values), Batch))
+                                break;
+
+                            benchmark::DoNotOptimize(values.data());
+                        }
+                    });
+
+                for (std::size_t i{0}; i < producers; ++i)
+                    threads.emplace_back([=] mutable {
+                        std::vector<std::size_t> values(Batch);
+
+                        for (std::size_t j{0}; j < Messages / producers; j += Batch) {
+                            std::span pending{values.data(), std::min(Batch, Messages / producers - j)};
+
+                            while (!pending.empty()) {
+                                const auto n = sender.sendMany(pending);
+
+                                if (!n)
+                                    return;
+
+                                pending = pending.subspan(*n);
+                            }
+                        }
+                    });
+            }
+
+            for (auto &thread: threads)
+                thread.join();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (Messages / producers * producers)));
+    }
+
+    // One producer and one consumer over `spscChannel`, to compare against `spsc` on the MPMC ring.
+    void spscDedicated(benchmark::State &state) {
+        const auto capacity = static_cast<std::size_t>(state.range(0));
+
+        for (auto _: state) {
+            auto [sender, receiver] = zero::concurrent::spscChannel<std::size_t>(capacity);
+
+            std::thread consumer{
+                [receiver = std::move(receiver)] mutable {
+                    while (true) {
+                        const auto value = receiver.receive();
+
+                        if (!value)
+                            break;
+
+                        benchmark::DoNotOptimize(*value);
+                    }
+                }
+            };
+
+            std::thread producer{
+                [sender = std::move(sender)] mutable {
+                    for (std::size_t i{0}; i < Messages; ++i)
+                        std::ignore = sender.send(i);
+
+                    sender.close();
+                }
+            };
+
+            producer.join();
+            consumer.join();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * Messages));
+    }
+
+    void spsc(benchmark::State &state) {
+        transfer(state, 1, 1);
+    }
+
+    void mpmc(benchmark::State &state) {
+        transfer(state, 4, 4);
+    }
+
+    void spscBatch(benchmark::State &state) {
+        transferBatch(state, 1, 1);
+    }
+
+    void mpmcBatch(benchmark::State &state) {
+        transferBatch(state, 4, 4);
+    }
+
+    void trySendReceive(benchmark::State &state) {
+        auto [sender, receiver] = zero::concurrent::channel<std::size_t>(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _: state) {
+            std::ignore = sender.trySend(1);
+            benchmark::DoNotOptimize(receiver.tryReceive());
+        }
+    }
+}
+
+BENCHMARK(spsc)->RangeMultiplier(8)->Range(1, 4096)->UseRealTime();
+BENCHMARK(spscDedicated)->RangeMultiplier(8)->Range(1, 4096)->UseRealTime();
+BENCHMARK(mpmc)->RangeMultiplier(8)->Range(1, 4096)->UseRealTime();
+BENCHMARK(spscBatch)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+BENCHMARK(mpmcBatch)->RangeMultiplier(8)->Range(64, 4096)->UseRealTime();
+BENCHMARK(trySendReceive)->Arg(1)->Arg(1024);
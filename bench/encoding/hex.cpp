@@ -0,0 +1,34 @@
+#include <zero/encoding/hex.h>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <algorithm>
+
+namespace {
+    std::vector<std::byte> randomBytes(const std::size_t size) {
+        std::minstd_rand engine{0};
+        std::vector<std::byte> bytes(size);
+        std::ranges::generate(bytes, [&] { return static_cast<std::byte>(engine()); });
+        return bytes;
+    }
+
+    void hexEncode(benchmark::State &state) {
+        const auto data = randomBytes(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _: state)
+            benchmark::DoNotOptimize(zero::encoding::hex::encode(data));
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    void hexDecode(benchmark::State &state) {
+        const auto encoded = zero::encoding::hex::encode(randomBytes(static_cast<std::size_t>(state.range(0))));
+
+        for (auto _: state)
+            benchmark::DoNotOptimize(zero::encoding::hex::decode(encoded));
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(encoded.size()));
+    }
+}
+
+BENCHMARK(hexEncode)->Arg(64)->Arg(1 << 20);
+BENCHMARK(hexDecode)->Arg(64)->Arg(1 << 20);
@@ -0,0 +1,34 @@
+#include <zero/io/buffer.h>
+#include <benchmark/benchmark.h>
+
+namespace {
+    // The first argument is the line length, the second the capacity of the reader.
+    void readLine(benchmark::State &state) {
+        const auto length = static_cast<std::size_t>(state.range(0));
+        const auto capacity = static_cast<std::size_t>(state.range(1));
+
+        std::string input;
+
+        while (input.size() < (std::size_t{1} << 20)) {
+            input.append(length, 'a');
+            input.push_back('\n');
+        }
+
+        for (auto _: state) {
+            zero::io::BufReader reader{zero::io::StringReader{input}, capacity};
+
+            while (true) {
+                auto line = reader.readLine();
+
+                if (!line)
+                    break;
+
+                benchmark::DoNotOptimize(line);
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input.size()));
+    }
+}
+
+BENCHMARK(readLine)->ArgsProduct({{16, 256, 4096}, {4096, 65536}});
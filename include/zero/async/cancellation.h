@@ -0,0 +1,74 @@
+#ifndef ZERO_ASYNC_CANCELLATION_H
+#define ZERO_ASYNC_CANCELLATION_H
+
+#include <memory>
+#include <cstdint>
+#include <zero/function.h>
+
+namespace zero::async {
+    class CancellationToken;
+
+    // Unregisters its callback when destroyed, a callback that has already started running is not waited for.
+    class CancellationSubscription {
+    public:
+        CancellationSubscription() = default;
+        CancellationSubscription(CancellationSubscription &&rhs) noexcept;
+        CancellationSubscription &operator=(CancellationSubscription &&rhs) noexcept;
+        ~CancellationSubscription();
+
+        void reset();
+
+    private:
+        struct State;
+
+        CancellationSubscription(std::shared_ptr<State> state, std::uint64_t id);
+
+        std::shared_ptr<State> mState;
+        std::uint64_t mID{};
+
+        friend class CancellationSource;
+        friend class CancellationToken;
+    };
+
+    class CancellationSource {
+    public:
+        CancellationSource();
+        // The source is cancelled together with `parent`, but cancelling it does not affect `parent`.
+        explicit CancellationSource(const CancellationToken &parent);
+
+        bool cancel();
+
+        [[nodiscard]] bool cancelled() const;
+        [[nodiscard]] CancellationToken token() const;
+
+    private:
+        using State = CancellationSubscription::State;
+
+        explicit CancellationSource(std::shared_ptr<State> state);
+
+        std::shared_ptr<State> mState;
+    };
+
+    // A default-constructed token can never be cancelled.
+    class CancellationToken {
+    public:
+        CancellationToken() = default;
+
+        [[nodiscard]] bool cancellable() const;
+        [[nodiscard]] bool cancelled() const;
+
+        // The callback runs on the cancelling thread, or immediately if the token is already cancelled.
+        [[nodiscard]] CancellationSubscription subscribe(SmallFunction<void()> callback) const;
+
+    private:
+        using State = CancellationSubscription::State;
+
+        explicit CancellationToken(std::shared_ptr<State> state);
+
+        std::shared_ptr<State> mState;
+
+        friend class CancellationSource;
+    };
+}
+
+#endif //ZERO_ASYNC_CANCELLATION_H
@@ -2,14 +2,24 @@
 #define ZERO_ASYNC_PROMISE_H
 
 #include <any>
+#include <list>
+#include <mutex>
 #include <memory>
 #include <ranges>
+#include <thread>
+#include <vector>
 #include <cassert>
+#include <algorithm>
+#include <coroutine>
 #include <utility>
+#include <variant>
 #include <optional>
 #include <stdexcept>
 #include <fmt/format.h>
 #include <zero/error.h>
+#include <zero/function.h>
+#include <zero/async/timer.h>
+#include <zero/async/cancellation.h>
 #include <zero/atomic/event.h>
 #include <zero/meta/concepts.h>
 
@@ -18,42 +28,269 @@ namespace zero::async::promise {
         Pending,
         OnlyCallback,
         OnlyResult,
-        Done
+        Done,
+        Waiting
     };
 
+    Z_DEFINE_ERROR_CODE_EX(
+        TimeoutError,
+        "zero::async::promise::Future::timeout",
+        Elapsed, "Deadline has elapsed", std::errc::timed_out
+    )
+
+    Z_DEFINE_ERROR_CODE_EX(
+        TaskError,
+        "zero::async::promise::Task",
+        UnhandledException, "Coroutine exited with an exception", Z_DEFAULT_ERROR_CONDITION
+    )
+
     class IExecutor {
     public:
         virtual ~IExecutor() = default;
         virtual void post(std::function<void()> f) = 0;
+
+        // Executors that can store move-only tasks should override this, the fallback boxes the task once more.
+        virtual void post(SmallFunction<void()> task) {
+            post(std::function<void()>{
+                [task = std::make_shared<SmallFunction<void()>>(std::move(task))] {
+                    (*task)();
+                }
+            });
+        }
+
+        template<typename F>
+            requires (
+                std::is_invocable_v<std::decay_t<F> &> &&
+                !std::is_same_v<std::remove_cvref_t<F>, std::function<void()>> &&
+                !std::is_same_v<std::remove_cvref_t<F>, SmallFunction<void()>>
+            )
+        void post(F &&f) {
+            post(SmallFunction<void()>{std::forward<F>(f)});
+        }
     };
 
     class InlineExecutor : public IExecutor {
     public:
         static std::shared_ptr<InlineExecutor> instance();
 
+        using IExecutor::post;
+        void post(std::function<void()> f) override;
+        void post(SmallFunction<void()> task) override;
+    };
+
+    class ThreadPoolExecutor final : public IExecutor {
+        struct Task;
+        struct Worker;
+
+    public:
+        explicit ThreadPoolExecutor(std::size_t concurrency = std::thread::hardware_concurrency());
+        ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+        ThreadPoolExecutor &operator=(const ThreadPoolExecutor &) = delete;
+        ~ThreadPoolExecutor() override;
+
+    private:
+        static Worker *&current();
+
+        void dispatch(std::size_t index);
+        static void recycle(Worker &worker, Task *task);
+        void wake();
+        Task *find(Worker &worker);
+        Task *inject(Worker &worker);
+        Task *steal(const Worker &worker);
+
+    public:
+        using IExecutor::post;
         void post(std::function<void()> f) override;
+        void post(SmallFunction<void()> task) override;
+        [[nodiscard]] std::size_t concurrency() const;
+
+    private:
+        std::atomic<bool> mStopped;
+        std::atomic<Task *> mInjection;
+        std::atomic<std::size_t> mSleeping;
+        std::atomic<std::uint32_t> mEpoch;
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+    };
+
+    template<typename T, typename E>
+    struct Core;
+
+    struct PoolStatistics {
+        std::size_t hits{};
+        std::size_t misses{};
+    };
+
+    // Per-thread free-list of `Core<T, E>` blocks. A block is returned to the pool of the thread that releases it, the
+    // cache of each thread is bounded, and whatever is cached is handed back to the global allocator at thread exit.
+    template<typename T, typename E>
+    class CorePool {
+        static constexpr std::size_t MaxCached = 1024;
+
+        struct Node {
+            Node *next;
+        };
+
+        struct Counter {
+            std::atomic<std::size_t> hits;
+            std::atomic<std::size_t> misses;
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::list<const Counter *> counters;
+            PoolStatistics retired;
+        };
+
+        struct Local {
+            Local() {
+                auto &registry = CorePool::registry();
+                std::lock_guard guard{registry.mutex};
+                registry.counters.push_back(&counter);
+            }
+
+            Local(const Local &) = delete;
+            Local &operator=(const Local &) = delete;
+
+            ~Local() {
+                destroyed() = true;
+
+                while (head)
+                    release(std::exchange(head, head->next));
+
+                auto &registry = CorePool::registry();
+                std::lock_guard guard{registry.mutex};
+                registry.counters.remove(&counter);
+                registry.retired.hits += counter.hits.load(std::memory_order_relaxed);
+                registry.retired.misses += counter.misses.load(std::memory_order_relaxed);
+            }
+
+            Node *head{};
+            std::size_t size{};
+            Counter counter{};
+        };
+
+        // Intentionally leaked, threads may still exit after static destructors have run.
+        static Registry &registry() {
+            static const auto instance = new Registry();
+            return *instance;
+        }
+
+        static bool &destroyed() {
+            thread_local bool flag{false};
+            return flag;
+        }
+
+        static Local &local() {
+            thread_local Local instance;
+            return instance;
+        }
+
+        // Only the owning thread writes its counters, a relaxed load-store pair avoids a locked instruction.
+        static void increase(std::atomic<std::size_t> &counter) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        static void *acquire(const std::size_t size) {
+            return ::operator new(size, std::align_val_t{Alignment});
+        }
+
+        static void release(void *ptr) {
+            ::operator delete(ptr, std::align_val_t{Alignment});
+        }
+
+    public:
+        static constexpr std::size_t Size = std::max(sizeof(Core<T, E>), sizeof(Node));
+        static constexpr std::size_t Alignment = std::max(alignof(Core<T, E>), alignof(Node));
+
+        static void *allocate() {
+            if (destroyed())
+                return acquire(Size);
+
+            auto &pool = local();
+
+            if (!pool.head) {
+                increase(pool.counter.misses);
+                return acquire(Size);
+            }
+
+            increase(pool.counter.hits);
+            --pool.size;
+            return std::exchange(pool.head, pool.head->next);
+        }
+
+        static void deallocate(void *ptr) {
+            if (destroyed()) {
+                release(ptr);
+                return;
+            }
+
+            auto &pool = local();
+
+            if (pool.size >= MaxCached) {
+                release(ptr);
+                return;
+            }
+
+            pool.head = std::construct_at(static_cast<Node *>(ptr), pool.head);
+            ++pool.size;
+        }
+
+        // Aggregated over all threads, including the ones that have already exited.
+        static PoolStatistics statistics() {
+            auto &registry = CorePool::registry();
+            std::lock_guard guard{registry.mutex};
+
+            auto result = registry.retired;
+
+            for (const auto &counter: registry.counters) {
+                result.hits += counter->hits.load(std::memory_order_relaxed);
+                result.misses += counter->misses.load(std::memory_order_relaxed);
+            }
+
+            return result;
+        }
     };
 
+    template<typename T, typename E>
+    class CorePtr;
+
     template<typename T, typename E>
     struct Core {
+        std::atomic<std::size_t> references{1};
+        // Only touched once a blocking wait() has moved the state to `Waiting`.
         atomic::Event event{true};
         std::atomic<State> state{State::Pending};
+        // Remembers a blocked wait() once attaching the callback has replaced `Waiting` with `OnlyCallback`, written
+        // before that CAS and read after the one that settles the core.
+        bool waited{false};
         std::optional<std::expected<T, E>> result;
-        std::function<void(std::expected<T, E>)> callback;
+        SmallFunction<void(std::expected<T, E>)> callback;
         std::shared_ptr<IExecutor> executor;
+        // Shared by every step of a chain, empty unless the chain was created with a cancellation token.
+        std::optional<CancellationSource> cancellation;
 
-        void trigger() {
-            assert(state == State::Done);
-            assert(executor);
+        static void *operator new(const std::size_t size) {
+            assert(size == sizeof(Core));
+            return CorePool<T, E>::allocate();
+        }
 
-            executor->post(
-                [
-                    callback = std::move(callback),
-                    result = std::make_shared<std::expected<T, E>>(*std::exchange(result, std::nullopt))
-                ] {
-                    callback(std::move(*result));
+        static void operator delete(void *ptr) {
+            CorePool<T, E>::deallocate(ptr);
+        }
+
+        // The posted task only holds a reference to the core, so it always fits into the inline storage of the task.
+        static void trigger(CorePtr<T, E> core) {
+            assert(core->state == State::Done);
+            assert(core->executor);
+
+            const auto executor = core->executor.get();
+
+            executor->post(SmallFunction<void()>{
+                [core = std::move(core)] {
+                    auto callback = std::exchange(core->callback, nullptr);
+                    callback(*std::exchange(core->result, std::nullopt));
                 }
-            );
+            });
         }
 
         [[nodiscard]] bool hasResult() const {
@@ -62,22 +299,102 @@ namespace zero::async::promise {
         }
     };
 
+    // Intrusive reference to a `Core`, the count lives in the core itself so that sharing it never allocates.
+    template<typename T, typename E>
+    class CorePtr {
+    public:
+        CorePtr() = default;
+
+        // ReSharper disable once CppNonExplicitConvertingConstructor
+        CorePtr(std::nullptr_t) {
+        }
+
+        // Adopts the reference the core was created with.
+        explicit CorePtr(Core<T, E> *core) : mCore{core} {
+        }
+
+        CorePtr(const CorePtr &rhs) : mCore{rhs.mCore} {
+            if (mCore)
+                mCore->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        CorePtr(CorePtr &&rhs) noexcept : mCore{std::exchange(rhs.mCore, nullptr)} {
+        }
+
+        CorePtr &operator=(CorePtr rhs) noexcept {
+            std::swap(mCore, rhs.mCore);
+            return *this;
+        }
+
+        ~CorePtr() {
+            reset();
+        }
+
+        void reset() {
+            if (!mCore)
+                return;
+
+            if (const auto core = std::exchange(mCore, nullptr);
+                core->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete core;
+        }
+
+        [[nodiscard]] Core<T, E> *get() const {
+            return mCore;
+        }
+
+        Core<T, E> *operator->() const {
+            assert(mCore);
+            return mCore;
+        }
+
+        Core<T, E> &operator*() const {
+            assert(mCore);
+            return *mCore;
+        }
+
+        explicit operator bool() const {
+            return mCore != nullptr;
+        }
+
+        bool operator==(std::nullptr_t) const {
+            return mCore == nullptr;
+        }
+
+    private:
+        Core<T, E> *mCore{};
+    };
+
+    template<typename T, typename E>
+    CorePtr<T, E> makeCore() {
+        return CorePtr<T, E>{new Core<T, E>()};
+    }
+
     template<typename T, typename E = std::exception_ptr>
     class SemiFuture;
 
     template<typename T, typename E = std::exception_ptr>
     class Future;
 
+    template<typename T, typename E>
+    class FutureAwaiter;
+
     template<typename T, typename E = std::exception_ptr>
     class Promise {
     public:
         using value_type = T;
         using error_type = E;
 
-        Promise() : mRetrieved{false}, mCore{std::make_shared<Core<T, E>>()} {
+        Promise() : mRetrieved{false}, mCore{makeCore<T, E>()} {
         }
 
-        explicit Promise(std::shared_ptr<Core<T, E>> core) : mRetrieved{false}, mCore{std::move(core)} {
+        explicit Promise(CorePtr<T, E> core) : mRetrieved{false}, mCore{std::move(core)} {
+        }
+
+        // The promise is cancelled together with `token`, or when a future of its chain is cancelled.
+        explicit Promise(const CancellationToken &token) : Promise{} {
+            if (token.cancellable())
+                mCore->cancellation.emplace(token);
         }
 
         Promise(Promise &&rhs) noexcept
@@ -101,6 +418,21 @@ namespace zero::async::promise {
             return true;
         }
 
+        // The producer observes this token to abandon work that nobody is waiting for anymore.
+        [[nodiscard]] CancellationToken token() const {
+            assert(mCore);
+
+            if (!mCore->cancellation)
+                return {};
+
+            return mCore->cancellation->token();
+        }
+
+        [[nodiscard]] bool isCancelled() const {
+            assert(mCore);
+            return mCore->cancellation && mCore->cancellation->cancelled();
+        }
+
         SemiFuture<T, E> getFuture() {
             assert(mCore);
 
@@ -118,20 +450,7 @@ namespace zero::async::promise {
             assert(mCore->state != State::Done);
 
             mCore->result.emplace();
-            auto state = mCore->state.load();
-
-            if (state == State::Pending && mCore->state.compare_exchange_strong(state, State::OnlyResult)) {
-                mCore->event.set();
-                return;
-            }
-
-            if (state != State::OnlyCallback || !mCore->state.compare_exchange_strong(state, State::Done))
-                throw error::StacktraceError<std::logic_error>{
-                    fmt::format("Unexpected promise state: {}", std::to_underlying(state))
-                };
-
-            mCore->event.set();
-            mCore->trigger();
+            settle();
         }
 
         template<typename U = T>
@@ -143,20 +462,7 @@ namespace zero::async::promise {
             assert(mCore->state != State::Done);
 
             mCore->result.emplace(std::in_place, std::forward<U>(value));
-            auto state = mCore->state.load();
-
-            if (state == State::Pending && mCore->state.compare_exchange_strong(state, State::OnlyResult)) {
-                mCore->event.set();
-                return;
-            }
-
-            if (state != State::OnlyCallback || !mCore->state.compare_exchange_strong(state, State::Done))
-                throw error::StacktraceError<std::logic_error>{
-                    fmt::format("Unexpected promise state: {}", std::to_underlying(state))
-                };
-
-            mCore->event.set();
-            mCore->trigger();
+            settle();
         }
 
         template<typename U>
@@ -168,10 +474,26 @@ namespace zero::async::promise {
             assert(mCore->state != State::Done);
 
             mCore->result.emplace(std::unexpect, std::forward<U>(error));
+            settle();
+        }
+
+        void reject(const std::derived_from<std::exception> auto &exception)
+            requires std::same_as<E, std::exception_ptr> {
+            reject(std::make_exception_ptr(exception));
+        }
+
+    private:
+        void settle() {
             auto state = mCore->state.load();
 
-            if (state == State::Pending && mCore->state.compare_exchange_strong(state, State::OnlyResult)) {
-                mCore->event.set();
+            while (state == State::Pending || state == State::Waiting) {
+                if (!mCore->state.compare_exchange_weak(state, State::OnlyResult))
+                    continue;
+
+                // only a blocked wait() armed the event, settling a callback-only chain is this single CAS
+                if (state == State::Waiting)
+                    mCore->event.set();
+
                 return;
             }
 
@@ -180,26 +502,24 @@ namespace zero::async::promise {
                     fmt::format("Unexpected promise state: {}", std::to_underlying(state))
                 };
 
-            mCore->event.set();
-            mCore->trigger();
-        }
+            if (mCore->waited)
+                mCore->event.set();
 
-        void reject(const std::derived_from<std::exception> auto &exception)
-            requires std::same_as<E, std::exception_ptr> {
-            reject(std::make_exception_ptr(exception));
+            Core<T, E>::trigger(mCore);
         }
 
-    private:
         bool mRetrieved;
-        std::shared_ptr<Core<T, E>> mCore;
+        CorePtr<T, E> mCore;
+
+        friend class CancellationGroup;
     };
 
     template<typename T, typename E = std::exception_ptr>
     using Contract = std::pair<Promise<T, E>, Future<T, E>>;
 
     template<typename T, typename E = std::exception_ptr>
-    Contract<T, E> contract(std::shared_ptr<IExecutor> executor) {
-        Promise<T, E> promise;
+    Contract<T, E> contract(std::shared_ptr<IExecutor> executor, const CancellationToken &token = {}) {
+        Promise<T, E> promise{token};
         auto future = promise.getFuture().via(std::move(executor));
         return {std::move(promise), std::move(future)};
     }
@@ -324,7 +644,7 @@ namespace zero::async::promise {
         using value_type = T;
         using error_type = E;
 
-        explicit FutureBase(std::shared_ptr<Core<T, E>> core) : mCore{std::move(core)} {
+        explicit FutureBase(CorePtr<T, E> core) : mCore{std::move(core)} {
         }
 
         FutureBase(FutureBase &&rhs) noexcept : mCore{std::move(rhs.mCore)} {
@@ -344,6 +664,18 @@ namespace zero::async::promise {
             return mCore->hasResult();
         }
 
+        // Cancels every step of the chain this future belongs to, returns false if it is not cancellable or has
+        // already been cancelled. The producer decides how to settle a cancelled promise.
+        bool cancel() const {
+            assert(mCore);
+            return mCore->cancellation && mCore->cancellation->cancel();
+        }
+
+        [[nodiscard]] const std::optional<CancellationSource> &cancellation() const {
+            assert(mCore);
+            return mCore->cancellation;
+        }
+
         std::expected<T, E> &result() & {
             assert(mCore);
             assert(mCore->result);
@@ -372,7 +704,15 @@ namespace zero::async::promise {
         wait(const std::optional<std::chrono::milliseconds> timeout = std::nullopt) const {
             assert(mCore);
 
-            if (mCore->hasResult())
+            auto state = mCore->state.load();
+
+            // announce the waiter, so that the promise knows it has to set the event
+            while (state == State::Pending) {
+                if (mCore->state.compare_exchange_weak(state, State::Waiting))
+                    break;
+            }
+
+            if (state != State::Pending && state != State::Waiting)
                 return {};
 
             return mCore->event.wait(timeout);
@@ -396,7 +736,7 @@ namespace zero::async::promise {
         }
 
     protected:
-        std::shared_ptr<Core<T, E>> mCore;
+        CorePtr<T, E> mCore;
     };
 
     template<typename T, typename E>
@@ -433,6 +773,10 @@ namespace zero::async::promise {
             this->mCore->executor = std::move(executor);
             return Future<T, E>{std::move(this->mCore)};
         }
+
+        FutureAwaiter<T, E> operator co_await() && {
+            return FutureAwaiter<T, E>{std::move(*this).via()};
+        }
     };
 
     template<typename T, typename E>
@@ -469,7 +813,12 @@ namespace zero::async::promise {
             return SemiFuture<T, E>{std::move(this->mCore)};
         }
 
-        void setCallback(std::function<void(std::expected<T, E>)> callback) {
+        // The awaiting coroutine is resumed on the executor bound to this future.
+        FutureAwaiter<T, E> operator co_await() && {
+            return FutureAwaiter<T, E>{std::move(*this)};
+        }
+
+        void setCallback(SmallFunction<void(std::expected<T, E>)> callback) {
             assert(this->mCore);
             assert(!this->mCore->callback);
             assert(this->mCore->state != State::OnlyCallback);
@@ -478,15 +827,20 @@ namespace zero::async::promise {
 
             auto state = this->mCore->state.load();
 
-            if (state == State::Pending && this->mCore->state.compare_exchange_strong(state, State::OnlyCallback))
-                return;
+            while (state == State::Pending || state == State::Waiting) {
+                if (state == State::Waiting)
+                    this->mCore->waited = true;
+
+                if (this->mCore->state.compare_exchange_weak(state, State::OnlyCallback))
+                    return;
+            }
 
             if (state != State::OnlyResult || !this->mCore->state.compare_exchange_strong(state, State::Done))
                 throw error::StacktraceError<std::logic_error>{
                     fmt::format("Unexpected promise state: {}", std::to_underlying(state))
                 };
 
-            this->mCore->trigger();
+            Core<T, E>::trigger(this->mCore);
         }
 
         template<AsyncCallback<T> F>
@@ -499,23 +853,21 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<NextValue, E>(this->mCore->executor);
+            auto [core, future] = link<NextValue, E>();
 
             setCallback(
-                [
-                    promise = std::make_shared<Promise<NextValue, E>>(std::move(promise)), f = std::forward<F>(f)
-                ](std::expected<T, E> &&result) mutable {
+                [core = std::move(core), f = std::forward<F>(f)](std::expected<T, E> &&result) mutable {
                     auto next = std::move(result).transform(std::move(f));
 
                     if (!next) {
-                        promise->reject(std::move(next).error());
+                        Promise<NextValue, E>{std::move(core)}.reject(std::move(next).error());
                         return;
                     }
 
                     std::move(*next).then([=]<typename... Args>(Args &&... args) {
-                        promise->resolve(std::forward<Args>(args)...);
+                        Promise<NextValue, E>{core}.resolve(std::forward<Args>(args)...);
                     }).fail([=](E &&error) {
-                        promise->reject(std::move(error));
+                        Promise<NextValue, E>{core}.reject(std::move(error));
                     });
                 }
             );
@@ -533,27 +885,27 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<NextValue>(this->mCore->executor);
+            auto [promise, future] = chain<NextValue>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<NextValue>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     try {
                         auto next = std::move(result).transform(std::move(f));
 
                         if (!next) {
-                            promise->reject(std::move(next).error());
+                            promise.reject(std::move(next).error());
                             return;
                         }
 
                         if constexpr (std::is_void_v<NextValue>)
-                            promise->resolve();
+                            promise.resolve();
                         else
-                            promise->resolve(*std::move(next));
+                            promise.resolve(*std::move(next));
                     }
                     catch (const std::exception &) {
-                        promise->reject(std::current_exception());
+                        promise.reject(std::current_exception());
                     }
                 }
             );
@@ -571,23 +923,23 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<NextValue, E>(this->mCore->executor);
+            auto [promise, future] = chain<NextValue, E>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<NextValue, E>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     auto next = std::move(result).and_then(std::move(f));
 
                     if (!next) {
-                        promise->reject(std::move(next).error());
+                        promise.reject(std::move(next).error());
                         return;
                     }
 
                     if constexpr (std::is_void_v<NextValue>)
-                        promise->resolve();
+                        promise.resolve();
                     else
-                        promise->resolve(*std::move(next));
+                        promise.resolve(*std::move(next));
                 }
             );
 
@@ -604,23 +956,23 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<NextValue, E>(this->mCore->executor);
+            auto [promise, future] = chain<NextValue, E>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<NextValue, E>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     auto next = std::move(result).transform(std::move(f));
 
                     if (!next) {
-                        promise->reject(std::move(next).error());
+                        promise.reject(std::move(next).error());
                         return;
                     }
 
                     if constexpr (std::is_void_v<NextValue>)
-                        promise->resolve();
+                        promise.resolve();
                     else
-                        promise->resolve(*std::move(next));
+                        promise.resolve(*std::move(next));
                 }
             );
 
@@ -662,27 +1014,25 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<T, NextError>(this->mCore->executor);
+            auto [core, future] = link<T, NextError>();
 
             setCallback(
-                [
-                    promise = std::make_shared<Promise<T, NextError>>(std::move(promise)), f = std::forward<F>(f)
-                ](std::expected<T, E> &&result) mutable {
+                [core = std::move(core), f = std::forward<F>(f)](std::expected<T, E> &&result) mutable {
                     if (!result) {
                         std::invoke(std::move(f), std::move(result).error()).then(
                             [=]<typename... Args>(Args &&... args) {
-                                promise->resolve(std::forward<Args>(args)...);
+                                Promise<T, NextError>{core}.resolve(std::forward<Args>(args)...);
                             }).fail([=](NextError &&error) {
-                            promise->reject(std::move(error));
+                            Promise<T, NextError>{core}.reject(std::move(error));
                         });
 
                         return;
                     }
 
                     if constexpr (std::is_void_v<T>)
-                        promise->resolve();
+                        Promise<T, NextError>{std::move(core)}.resolve();
                     else
-                        promise->resolve(*std::move(result));
+                        Promise<T, NextError>{std::move(core)}.resolve(*std::move(result));
                 }
             );
 
@@ -698,21 +1048,21 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<T, NextError>(this->mCore->executor);
+            auto [promise, future] = chain<T, NextError>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<T, NextError>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     if (!result) {
-                        promise->reject(std::invoke(std::move(f), std::move(result).error()).error());
+                        promise.reject(std::invoke(std::move(f), std::move(result).error()).error());
                         return;
                     }
 
                     if constexpr (std::is_void_v<T>)
-                        promise->resolve();
+                        promise.resolve();
                     else
-                        promise->resolve(*std::move(result));
+                        promise.resolve(*std::move(result));
                 }
             );
 
@@ -729,32 +1079,32 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<T>(this->mCore->executor);
+            auto [promise, future] = chain<T>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<T>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     try {
                         if (!result) {
                             if constexpr (std::is_void_v<T>) {
                                 std::invoke(std::move(f), std::move(result).error());
-                                promise->resolve();
+                                promise.resolve();
                             }
                             else {
-                                promise->resolve(std::invoke(std::move(f), std::move(result).error()));
+                                promise.resolve(std::invoke(std::move(f), std::move(result).error()));
                             }
 
                             return;
                         }
 
                         if constexpr (std::is_void_v<T>)
-                            promise->resolve();
+                            promise.resolve();
                         else
-                            promise->resolve(*std::move(result));
+                            promise.resolve(*std::move(result));
                     }
                     catch (const std::exception &) {
-                        promise->reject(std::current_exception());
+                        promise.reject(std::current_exception());
                     }
                 }
             );
@@ -794,23 +1144,23 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<T, NextError>(this->mCore->executor);
+            auto [promise, future] = chain<T, NextError>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<T, NextError>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     auto next = std::move(result).or_else(std::move(f));
 
                     if (!next) {
-                        promise->reject(std::move(next).error());
+                        promise.reject(std::move(next).error());
                         return;
                     }
 
                     if constexpr (std::is_void_v<T>)
-                        promise->resolve();
+                        promise.resolve();
                     else
-                        promise->resolve(*std::move(next));
+                        promise.resolve(*std::move(next));
                 }
             );
 
@@ -827,28 +1177,28 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<T, E>(this->mCore->executor);
+            auto [promise, future] = chain<T, E>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<T, E>>(std::move(promise)), f = std::forward<F>(f)
+                    promise = std::move(promise), f = std::forward<F>(f)
                 ](std::expected<T, E> &&result) mutable {
                     if (!result) {
                         if constexpr (std::is_void_v<T>) {
                             std::invoke(std::move(f), std::move(result).error());
-                            promise->resolve();
+                            promise.resolve();
                         }
                         else {
-                            promise->resolve(std::invoke(std::move(f), std::move(result).error()));
+                            promise.resolve(std::invoke(std::move(f), std::move(result).error()));
                         }
 
                         return;
                     }
 
                     if constexpr (std::is_void_v<T>)
-                        promise->resolve();
+                        promise.resolve();
                     else
-                        promise->resolve(*std::move(result));
+                        promise.resolve(*std::move(result));
                 }
             );
 
@@ -861,77 +1211,305 @@ namespace zero::async::promise {
             assert(this->mCore->state != State::OnlyCallback);
             assert(this->mCore->state != State::Done);
 
-            auto [promise, future] = contract<T, E>(this->mCore->executor);
+            auto [promise, future] = chain<T, E>();
 
             setCallback(
                 [
-                    promise = std::make_shared<Promise<T, E>>(std::move(promise)), f = std::move(f)
+                    promise = std::move(promise), f = std::move(f)
                 ](std::expected<T, E> &&result) mutable {
                     if (!result) {
                         f();
-                        promise->reject(std::move(result).error());
+                        promise.reject(std::move(result).error());
                         return;
                     }
 
                     f();
 
                     if constexpr (std::is_void_v<T>) {
-                        promise->resolve();
+                        promise.resolve();
                     }
                     else {
-                        promise->resolve(*std::move(result));
+                        promise.resolve(*std::move(result));
                     }
                 }
             );
 
             return std::move(future);
         }
-    };
 
-    template<typename T>
-    struct OptionalWrapperImpl;
+        // Rejects with `TimeoutError::Elapsed` unless this future settles within `duration`, the pending timer is
+        // cancelled as soon as it does.
+        Future timeout(
+            const std::chrono::milliseconds duration,
+            std::shared_ptr<TimerWheel> wheel = TimerWheel::instance()
+        ) && requires (std::same_as<E, std::exception_ptr> || std::constructible_from<E, std::error_code>) {
+            assert(this->mCore);
+            assert(!this->mCore->callback);
+            assert(this->mCore->state != State::OnlyCallback);
+            assert(this->mCore->state != State::Done);
 
-    template<typename T>
-    struct OptionalWrapperImpl<std::vector<T>> {
-        using Type = std::vector<std::optional<T>>;
-    };
+            struct Context {
+                Promise<T, E> promise;
+                std::atomic_flag flag;
+                TimerWheel::TimerID timer{};
+                std::optional<CancellationSource> cancellation;
+            };
 
-    template<typename T, std::size_t N>
-    struct OptionalWrapperImpl<std::array<T, N>> {
-        using Type = std::array<std::optional<T>, N>;
-    };
+            auto [promise, future] = chain<T, E>();
+            const auto ctx = std::make_shared<Context>(std::move(promise));
+            ctx->cancellation = this->mCore->cancellation;
 
-    template<typename... Ts>
-    struct OptionalWrapperImpl<std::tuple<Ts...>> {
-        using Type = std::tuple<std::optional<Ts>...>;
-    };
+            ctx->timer = wheel->add(duration, [=] {
+                if (ctx->flag.test_and_set())
+                    return;
 
-    template<typename T>
-    using OptionalWrapper = OptionalWrapperImpl<T>::Type;
+                // nobody is waiting for the result anymore, withdraw the operation before the timeout is observed, so
+                // that it cannot complete after its caller has already been told it did not
+                if (ctx->cancellation)
+                    ctx->cancellation->cancel();
+
+                if constexpr (std::same_as<E, std::exception_ptr>)
+                    ctx->promise.reject(std::make_exception_ptr(
+                        std::system_error{make_error_code(TimeoutError::Elapsed)}
+                    ));
+                else
+                    ctx->promise.reject(make_error_code(TimeoutError::Elapsed));
+            });
 
-    template<typename T>
-    std::vector<T> unwrap(std::vector<std::optional<T>> &&vector) {
-        return vector
-            | std::views::as_rvalue
-            | std::views::transform([](std::optional<T> &&value) {
-                assert(value);
-                return *std::move(value);
-            })
-            | std::ranges::to<std::vector>();
-    }
+            setCallback([ctx, wheel = std::move(wheel)](std::expected<T, E> &&result) {
+                if (ctx->flag.test_and_set())
+                    return;
 
-    template<std::size_t... Is, typename T, std::size_t N>
-    std::array<T, N> unwrap(std::index_sequence<Is...>, std::array<std::optional<T>, N> &&array) {
-        assert((std::get<Is>(array) && ...));
-        return {*std::move(std::get<Is>(array))...};
-    }
+                wheel->cancel(ctx->timer);
 
-    template<typename T, std::size_t N>
-    std::array<T, N> unwrap(std::array<std::optional<T>, N> &&array) {
-        return unwrap(std::make_index_sequence<N>{}, std::move(array));
-    }
+                if (!result) {
+                    ctx->promise.reject(std::move(result).error());
+                    return;
+                }
 
-    template<std::size_t... Is, typename... Ts>
+                if constexpr (std::is_void_v<T>)
+                    ctx->promise.resolve();
+                else
+                    ctx->promise.resolve(*std::move(result));
+            });
+
+            return std::move(future);
+        }
+
+    private:
+        // The next step shares the cancellation source of this one, so cancelling any step reaches the producer.
+        template<typename U, typename F = std::exception_ptr>
+        Contract<U, F> chain() const {
+            auto [core, future] = link<U, F>();
+            return {Promise<U, F>{std::move(core)}, std::move(future)};
+        }
+
+        // Like `chain()`, but hands out the core itself for callbacks that settle the next step from more than one
+        // place, each of them wraps its own reference into a `Promise` instead of sharing one on the heap.
+        template<typename U, typename F = std::exception_ptr>
+        std::pair<CorePtr<U, F>, Future<U, F>> link() const {
+            auto core = makeCore<U, F>();
+            core->cancellation = this->mCore->cancellation;
+
+            auto future = Promise<U, F>{core}.getFuture().via(this->mCore->executor);
+            return {std::move(core), std::move(future)};
+        }
+    };
+
+    template<typename T, typename E>
+    class FutureAwaiter {
+    public:
+        explicit FutureAwaiter(Future<T, E> future) : mFuture{std::move(future)} {
+        }
+
+        [[nodiscard]] bool await_ready() const {
+            return mFuture.isReady();
+        }
+
+        void await_suspend(const std::coroutine_handle<> handle) {
+            // the coroutine may be resumed before setCallback returns, nothing must be touched afterward
+            mFuture.setCallback([=, this](std::expected<T, E> &&result) {
+                mResult.emplace(std::move(result));
+                handle.resume();
+            });
+        }
+
+        T await_resume() requires std::same_as<E, std::exception_ptr> {
+            auto result = take();
+
+            if (!result)
+                std::rethrow_exception(result.error());
+
+            if constexpr (std::is_void_v<T>)
+                return;
+            else
+                return *std::move(result);
+        }
+
+        std::expected<T, E> await_resume() requires (!std::same_as<E, std::exception_ptr>) {
+            return take();
+        }
+
+    private:
+        std::expected<T, E> take() {
+            if (mResult)
+                return *std::move(mResult);
+
+            return std::move(mFuture).result();
+        }
+
+        Future<T, E> mFuture;
+        std::optional<std::expected<T, E>> mResult;
+    };
+
+    template<typename T, typename E = std::exception_ptr>
+    class Task;
+
+    template<typename T, typename E>
+    class TaskPromiseBase {
+        // an exception escaping the coroutine has to settle the task with something
+        static_assert(
+            std::same_as<E, std::exception_ptr> || std::constructible_from<E, std::error_code>,
+            "the error type of a task must be std::exception_ptr or constructible from std::error_code"
+        );
+
+    public:
+        TaskPromiseBase() : mCore{makeCore<T, E>()}, mPromise{mCore} {
+        }
+
+        Task<T, E> get_return_object() {
+            return Task<T, E>{mCore};
+        }
+
+        // The coroutine starts eagerly and destroys its own frame once done, the result lives in the core.
+        static std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        static std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        // Never rethrows: the exception would skip `final_suspend`, leaking the frame, and land in whoever resumed the
+        // coroutine, such as a pool worker. A task with an error code settles with the code of a `std::system_error`,
+        // or with `TaskError::UnhandledException` for anything else.
+        void unhandled_exception() {
+            if constexpr (std::same_as<E, std::exception_ptr>) {
+                mPromise.reject(std::current_exception());
+            }
+            else {
+                try {
+                    throw;
+                }
+                catch (const std::system_error &e) {
+                    mPromise.reject(e.code());
+                }
+                catch (...) {
+                    mPromise.reject(make_error_code(TaskError::UnhandledException));
+                }
+            }
+        }
+
+    protected:
+        CorePtr<T, E> mCore;
+        Promise<T, E> mPromise;
+    };
+
+    template<typename T, typename E>
+    class TaskPromise : public TaskPromiseBase<T, E> {
+    public:
+        void return_value(std::expected<T, E> result) {
+            if (!result) {
+                this->mPromise.reject(std::move(result).error());
+                return;
+            }
+
+            if constexpr (std::is_void_v<T>)
+                this->mPromise.resolve();
+            else
+                this->mPromise.resolve(*std::move(result));
+        }
+    };
+
+    template<typename T>
+    class TaskPromise<T, std::exception_ptr> : public TaskPromiseBase<T, std::exception_ptr> {
+    public:
+        template<typename U = T>
+            requires std::constructible_from<T, U>
+        void return_value(U &&value) {
+            this->mPromise.resolve(std::forward<U>(value));
+        }
+    };
+
+    template<>
+    class TaskPromise<void, std::exception_ptr> : public TaskPromiseBase<void, std::exception_ptr> {
+    public:
+        void return_void() {
+            mPromise.resolve();
+        }
+    };
+
+    // Coroutine return type, every co_await inside the coroutine reuses the frame instead of chaining new futures.
+    template<typename T, typename E>
+    class Task final : public FutureBase<T, E> {
+    public:
+        using promise_type = TaskPromise<T, E>;
+        using FutureBase<T, E>::FutureBase;
+
+        Future<T, E> via(std::shared_ptr<IExecutor> executor = InlineExecutor::instance()) && {
+            this->mCore->executor = std::move(executor);
+            return Future<T, E>{std::move(this->mCore)};
+        }
+
+        FutureAwaiter<T, E> operator co_await() && {
+            return FutureAwaiter<T, E>{std::move(*this).via()};
+        }
+    };
+
+    template<typename T>
+    struct OptionalWrapperImpl;
+
+    template<typename T>
+    struct OptionalWrapperImpl<std::vector<T>> {
+        using Type = std::vector<std::optional<T>>;
+    };
+
+    template<typename T, std::size_t N>
+    struct OptionalWrapperImpl<std::array<T, N>> {
+        using Type = std::array<std::optional<T>, N>;
+    };
+
+    template<typename... Ts>
+    struct OptionalWrapperImpl<std::tuple<Ts...>> {
+        using Type = std::tuple<std::optional<Ts>...>;
+    };
+
+    template<typename T>
+    using OptionalWrapper = OptionalWrapperImpl<T>::Type;
+
+    template<typename T>
+    std::vector<T> unwrap(std::vector<std::optional<T>> &&vector) {
+        return vector
+            | std::views::as_rvalue
+            | std::views::transform([](std::optional<T> &&value) {
+                assert(value);
+                return *std::move(value);
+            })
+            | std::ranges::to<std::vector>();
+    }
+
+    template<std::size_t... Is, typename T, std::size_t N>
+    std::array<T, N> unwrap(std::index_sequence<Is...>, std::array<std::optional<T>, N> &&array) {
+        assert((std::get<Is>(array) && ...));
+        return {*std::move(std::get<Is>(array))...};
+    }
+
+    template<typename T, std::size_t N>
+    std::array<T, N> unwrap(std::array<std::optional<T>, N> &&array) {
+        return unwrap(std::make_index_sequence<N>{}, std::move(array));
+    }
+
+    template<std::size_t... Is, typename... Ts>
     std::tuple<Ts...> unwrap(std::index_sequence<Is...>, std::tuple<std::optional<Ts>...> &&tuple) {
         assert((std::get<Is>(tuple) && ...));
         return {*std::move(std::get<Is>(tuple))...};
@@ -942,6 +1520,188 @@ namespace zero::async::promise {
         return unwrap(std::index_sequence_for<Ts...>{}, std::move(tuple));
     }
 
+    // Fixed-size storage whose elements are constructed one slot at a time, possibly from different threads as long as
+    // every slot is written once. Only the constructed slots are destroyed.
+    template<typename T>
+    class ResultBuffer {
+    public:
+        explicit ResultBuffer(const std::size_t size)
+            : mSize{size}, mData{std::allocator<T>{}.allocate(size)}, mConstructed{new bool[size]{}} {
+        }
+
+        ResultBuffer(ResultBuffer &&rhs) noexcept
+            : mSize{std::exchange(rhs.mSize, 0)},
+              mData{std::exchange(rhs.mData, nullptr)},
+              mConstructed{std::move(rhs.mConstructed)} {
+        }
+
+        ResultBuffer &operator=(ResultBuffer &&rhs) noexcept {
+            if (this == &rhs)
+                return *this;
+
+            reset();
+
+            mSize = std::exchange(rhs.mSize, 0);
+            mData = std::exchange(rhs.mData, nullptr);
+            mConstructed = std::move(rhs.mConstructed);
+
+            return *this;
+        }
+
+        ~ResultBuffer() {
+            reset();
+        }
+
+        template<typename... Args>
+        T &emplace(const std::size_t index, Args &&... args) {
+            assert(index < mSize);
+            assert(!mConstructed[index]);
+
+            auto &element = *std::construct_at(mData + index, std::forward<Args>(args)...);
+            mConstructed[index] = true;
+
+            return element;
+        }
+
+        [[nodiscard]] bool constructed(const std::size_t index) const {
+            assert(index < mSize);
+            return mConstructed[index];
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return mSize;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return mSize == 0;
+        }
+
+        T &operator[](const std::size_t index) {
+            assert(constructed(index));
+            return mData[index];
+        }
+
+        const T &operator[](const std::size_t index) const {
+            assert(constructed(index));
+            return mData[index];
+        }
+
+        T *data() {
+            return mData;
+        }
+
+        const T *data() const {
+            return mData;
+        }
+
+        T *begin() {
+            return mData;
+        }
+
+        T *end() {
+            return mData + mSize;
+        }
+
+        const T *begin() const {
+            return mData;
+        }
+
+        const T *end() const {
+            return mData + mSize;
+        }
+
+    private:
+        void reset() {
+            if (!mData)
+                return;
+
+            for (std::size_t i{0}; i < mSize; ++i) {
+                if (mConstructed[i])
+                    std::destroy_at(mData + i);
+            }
+
+            std::allocator<T>{}.deallocate(std::exchange(mData, nullptr), mSize);
+            mConstructed.reset();
+            mSize = 0;
+        }
+
+        std::size_t mSize;
+        T *mData;
+        std::unique_ptr<bool[]> mConstructed;
+    };
+
+    // Cancels the inputs of an aggregate once its outcome is decided, and forwards cancellation of the aggregate itself.
+    class CancellationGroup {
+    public:
+        template<typename T, typename E>
+        void add(const FutureBase<T, E> &future) {
+            const auto &cancellation = future.cancellation();
+
+            if (!cancellation)
+                return;
+
+            {
+                std::lock_guard guard{mMutex};
+
+                if (!mCancelled) {
+                    mSources.push_back(*cancellation);
+                    return;
+                }
+            }
+
+            // the outcome was decided by an input that was already settled
+            auto source = *cancellation;
+            source.cancel();
+        }
+
+        void cancel() {
+            std::vector<CancellationSource> sources;
+
+            {
+                std::lock_guard guard{mMutex};
+
+                if (mCancelled)
+                    return;
+
+                mCancelled = true;
+                sources = std::exchange(mSources, {});
+            }
+
+            for (auto &source: sources)
+                source.cancel();
+        }
+
+        // Makes `ctx->promise` cancellable if any input is, the subscription only holds a weak reference to `ctx`.
+        template<typename Context>
+        static void bind(const std::shared_ptr<Context> &ctx) {
+            auto &group = ctx->group;
+
+            {
+                std::lock_guard guard{group.mMutex};
+
+                if (group.mSources.empty())
+                    return;
+            }
+
+            CancellationSource source;
+
+            group.mSubscription = source.token().subscribe(
+                [weak = std::weak_ptr{std::shared_ptr<CancellationGroup>{ctx, &group}}] {
+                    if (const auto group = weak.lock())
+                        group->cancel();
+                }
+            );
+
+            ctx->promise.mCore->cancellation = std::move(source);
+        }
+
+    private:
+        bool mCancelled{false};
+        std::mutex mMutex;
+        std::vector<CancellationSource> mSources;
+        CancellationSubscription mSubscription;
+    };
+
     template<std::input_iterator I, std::sentinel_for<I> S>
         requires meta::Specialization<std::iter_value_t<I>, Future>
     auto all(I first, S last) {
@@ -959,15 +1719,19 @@ namespace zero::async::promise {
                 Promise<void, E> promise;
                 std::atomic<std::size_t> count;
                 std::atomic_flag flag;
+                CancellationGroup group;
             };
 
             const auto ctx = std::make_shared<Context>(static_cast<std::size_t>(std::ranges::distance(first, last)));
 
             while (first != last) {
+                ctx->group.add(*first);
                 (*first++).setCallback([=](std::expected<T, E> &&result) {
                     if (!result) {
-                        if (!ctx->flag.test_and_set())
+                        if (!ctx->flag.test_and_set()) {
                             ctx->promise.reject(std::move(result).error());
+                            ctx->group.cancel();
+                        }
 
                         return;
                     }
@@ -979,6 +1743,8 @@ namespace zero::async::promise {
                 });
             }
 
+            CancellationGroup::bind(ctx);
+
             return ctx->promise.getFuture();
         }
         else {
@@ -989,6 +1755,7 @@ namespace zero::async::promise {
                 Promise<std::vector<T>, E> promise;
                 std::atomic<std::size_t> count;
                 std::atomic_flag flag;
+                CancellationGroup group;
                 OptionalWrapper<std::vector<T>> values;
             };
 
@@ -996,10 +1763,13 @@ namespace zero::async::promise {
 
             // Waiting for libc++ to implement std::ranges::views::enumerate
             for (std::size_t i{0}; first != last; ++first, ++i) {
+                ctx->group.add(*first);
                 (*first).setCallback([=](std::expected<T, E> &&result) {
                     if (!result) {
-                        if (!ctx->flag.test_and_set())
+                        if (!ctx->flag.test_and_set()) {
                             ctx->promise.reject(std::move(result).error());
+                            ctx->group.cancel();
+                        }
 
                         return;
                     }
@@ -1013,6 +1783,8 @@ namespace zero::async::promise {
                 });
             }
 
+            CancellationGroup::bind(ctx);
+
             return ctx->promise.getFuture();
         }
     }
@@ -1042,15 +1814,19 @@ namespace zero::async::promise {
                 Promise<void, E> promise;
                 std::atomic<std::size_t> count{sizeof...(Ts)};
                 std::atomic_flag flag;
+                CancellationGroup group;
             };
 
             const auto ctx = std::make_shared<Context>();
 
             ([&] {
+                ctx->group.add(futures);
                 futures.setCallback([=](std::expected<Ts, E> &&result) {
                     if (!result) {
-                        if (!ctx->flag.test_and_set())
+                        if (!ctx->flag.test_and_set()) {
                             ctx->promise.reject(std::move(result).error());
+                            ctx->group.cancel();
+                        }
 
                         return;
                     }
@@ -1062,6 +1838,8 @@ namespace zero::async::promise {
                 });
             }(), ...);
 
+            CancellationGroup::bind(ctx);
+
             return ctx->promise.getFuture();
         }
         else {
@@ -1069,16 +1847,20 @@ namespace zero::async::promise {
                 Promise<T, E> promise;
                 std::atomic<std::size_t> count{sizeof...(Ts)};
                 std::atomic_flag flag;
+                CancellationGroup group;
                 OptionalWrapper<T> values;
             };
 
             const auto ctx = std::make_shared<Context>();
 
             ([&] {
+                ctx->group.add(futures);
                 futures.setCallback([=](std::expected<Ts, E> &&result) {
                     if (!result) {
-                        if (!ctx->flag.test_and_set())
+                        if (!ctx->flag.test_and_set()) {
                             ctx->promise.reject(std::move(result).error());
+                            ctx->group.cancel();
+                        }
 
                         return;
                     }
@@ -1102,6 +1884,8 @@ namespace zero::async::promise {
                 });
             }(), ...);
 
+            CancellationGroup::bind(ctx);
+
             return ctx->promise.getFuture();
         }
     }
@@ -1111,6 +1895,244 @@ namespace zero::async::promise {
         return all(std::index_sequence_for<Ts...>{}, std::move(futures)...);
     }
 
+    // Like `all`, but every value is constructed in place in its slot of the result buffer instead of being staged in a
+    // `std::optional` and copied into a vector afterward.
+    template<std::input_iterator I, std::sentinel_for<I> S>
+        requires (
+            meta::Specialization<std::iter_value_t<I>, Future> &&
+            !std::is_void_v<typename std::iter_value_t<I>::value_type>
+        )
+    auto gather(I first, S last) {
+        if (first == last)
+            throw error::StacktraceError<std::invalid_argument>{"Range must not be empty"};
+
+        using T = std::iter_value_t<I>::value_type;
+        using E = std::iter_value_t<I>::error_type;
+
+        struct Context {
+            explicit Context(const std::size_t n) : count{n}, values{n} {
+            }
+
+            Promise<ResultBuffer<T>, E> promise;
+            std::atomic<std::size_t> count;
+            std::atomic_flag flag;
+            CancellationGroup group;
+            ResultBuffer<T> values;
+        };
+
+        const auto ctx = std::make_shared<Context>(static_cast<std::size_t>(std::ranges::distance(first, last)));
+
+        for (std::size_t i{0}; first != last; ++first, ++i) {
+            ctx->group.add(*first);
+            (*first).setCallback([=](std::expected<T, E> &&result) {
+                if (!result) {
+                    if (!ctx->flag.test_and_set()) {
+                        ctx->promise.reject(std::move(result).error());
+                        ctx->group.cancel();
+                    }
+
+                    return;
+                }
+
+                ctx->values.emplace(i, *std::move(result));
+
+                if (--ctx->count > 0)
+                    return;
+
+                ctx->promise.resolve(std::move(ctx->values));
+            });
+        }
+
+        CancellationGroup::bind(ctx);
+
+        return ctx->promise.getFuture();
+    }
+
+    template<std::ranges::input_range R>
+        requires meta::Specialization<std::ranges::range_value_t<R>, Future>
+    auto gather(R futures) {
+        return gather(futures.begin(), futures.end());
+    }
+
+    // Streams values to `f` as `f(index, value)` (`f(index)` for void) in completion order, without collecting them.
+    // `f` is invoked on the settling threads, possibly concurrently. The returned future settles like `all`, values
+    // settling after the first error are dropped.
+    template<std::input_iterator I, std::sentinel_for<I> S, typename F>
+        requires meta::Specialization<std::iter_value_t<I>, Future>
+    auto each(I first, S last, F f) {
+        if (first == last)
+            throw error::StacktraceError<std::invalid_argument>{"Range must not be empty"};
+
+        using T = std::iter_value_t<I>::value_type;
+        using E = std::iter_value_t<I>::error_type;
+
+        if constexpr (std::is_void_v<T>)
+            static_assert(std::is_invocable_v<F &, std::size_t>);
+        else
+            static_assert(std::is_invocable_v<F &, std::size_t, T>);
+
+        struct Context {
+            Context(const std::size_t n, F &&f) : count{n}, callback{std::move(f)} {
+            }
+
+            Promise<void, E> promise;
+            std::atomic<std::size_t> count;
+            std::atomic_flag flag;
+            CancellationGroup group;
+            F callback;
+        };
+
+        const auto ctx = std::make_shared<Context>(
+            static_cast<std::size_t>(std::ranges::distance(first, last)),
+            std::move(f)
+        );
+
+        for (std::size_t i{0}; first != last; ++first, ++i) {
+            ctx->group.add(*first);
+            (*first).setCallback([=](std::expected<T, E> &&result) {
+                if (!result) {
+                    if (!ctx->flag.test_and_set()) {
+                        ctx->promise.reject(std::move(result).error());
+                        ctx->group.cancel();
+                    }
+
+                    return;
+                }
+
+                if (ctx->flag.test())
+                    return;
+
+                if constexpr (std::is_void_v<T>)
+                    std::invoke(ctx->callback, i);
+                else
+                    std::invoke(ctx->callback, i, *std::move(result));
+
+                if (--ctx->count > 0)
+                    return;
+
+                if (!ctx->flag.test_and_set())
+                    ctx->promise.resolve();
+            });
+        }
+
+        CancellationGroup::bind(ctx);
+
+        return ctx->promise.getFuture();
+    }
+
+    template<std::ranges::input_range R, typename F>
+        requires meta::Specialization<std::ranges::range_value_t<R>, Future>
+    auto each(R futures, F f) {
+        return each(futures.begin(), futures.end(), std::move(f));
+    }
+
+    // Invokes `f` on every element with at most `limit` of the returned futures in flight, a lane starts the next
+    // element as soon as its previous future settles. Resolves with the values in range order, and rejects like `all`.
+    template<std::ranges::random_access_range R, typename F>
+        requires (
+            std::ranges::sized_range<R> &&
+            meta::Specialization<std::invoke_result_t<F &, std::ranges::range_reference_t<R>>, Future>
+        )
+    auto mapConcurrent(R range, const std::size_t limit, F f) {
+        if (limit == 0)
+            throw error::StacktraceError<std::invalid_argument>{"Concurrency limit must be greater than zero"};
+
+        using Result = std::invoke_result_t<F &, std::ranges::range_reference_t<R>>;
+        using T = Result::value_type;
+        using E = Result::error_type;
+        using V = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+        struct Context {
+            Context(R &&r, F &&fn, const std::size_t n, const std::size_t lanes)
+                : range{std::move(r)}, f{std::move(fn)}, size{n}, next{0}, remaining{n},
+                  handoffs{std::make_unique<std::atomic<int>[]>(lanes)}, values{std::is_void_v<T> ? 0 : n} {
+            }
+
+            // The lane loops as long as futures settle synchronously, so ready results cannot grow the stack. Whoever
+            // of the lane and the callback reaches the handoff second continues the lane.
+            static void launch(const std::shared_ptr<Context> &ctx, const std::size_t lane) {
+                auto &handoff = ctx->handoffs[lane];
+
+                while (!ctx->flag.test()) {
+                    const auto index = ctx->next.fetch_add(1, std::memory_order_relaxed);
+
+                    if (index >= ctx->size)
+                        return;
+
+                    auto future = std::invoke(ctx->f, std::ranges::begin(ctx->range)[index]);
+
+                    ctx->group.add(future);
+                    handoff.store(0, std::memory_order_relaxed);
+
+                    future.setCallback([=](std::expected<T, E> &&result) {
+                        if (!result) {
+                            if (!ctx->flag.test_and_set()) {
+                                ctx->promise.reject(std::move(result).error());
+                                ctx->group.cancel();
+                            }
+
+                            return;
+                        }
+
+                        if constexpr (!std::is_void_v<T>)
+                            ctx->values.emplace(index, *std::move(result));
+
+                        if (--ctx->remaining == 0) {
+                            if constexpr (std::is_void_v<T>)
+                                ctx->promise.resolve();
+                            else
+                                ctx->promise.resolve(
+                                    std::vector<T>(
+                                        std::make_move_iterator(ctx->values.begin()),
+                                        std::make_move_iterator(ctx->values.end())
+                                    )
+                                );
+
+                            return;
+                        }
+
+                        if (ctx->handoffs[lane].exchange(1, std::memory_order_acq_rel) == 2)
+                            launch(ctx, lane);
+                    });
+
+                    if (handoff.exchange(2, std::memory_order_acq_rel) == 0)
+                        return;
+                }
+            }
+
+            Promise<V, E> promise;
+            R range;
+            F f;
+            std::size_t size;
+            std::atomic<std::size_t> next;
+            std::atomic<std::size_t> remaining;
+            std::atomic_flag flag;
+            CancellationGroup group;
+            std::unique_ptr<std::atomic<int>[]> handoffs;
+            ResultBuffer<std::conditional_t<std::is_void_v<T>, std::monostate, T>> values;
+        };
+
+        const auto size = static_cast<std::size_t>(std::ranges::size(range));
+        const auto lanes = std::min(limit, size);
+        const auto ctx = std::make_shared<Context>(std::move(range), std::move(f), size, lanes);
+
+        if (size == 0) {
+            if constexpr (std::is_void_v<T>)
+                ctx->promise.resolve();
+            else
+                ctx->promise.resolve(std::vector<T>{});
+
+            return ctx->promise.getFuture();
+        }
+
+        for (std::size_t lane{0}; lane < lanes; ++lane)
+            Context::launch(ctx, lane);
+
+        CancellationGroup::bind(ctx);
+
+        return ctx->promise.getFuture();
+    }
+
     template<std::input_iterator I, std::sentinel_for<I> S>
         requires meta::Specialization<std::iter_value_t<I>, Future>
     auto allSettled(I first, S last) {
@@ -1244,12 +2266,14 @@ namespace zero::async::promise {
             Promise<T, std::vector<E>> promise;
             std::atomic<std::size_t> count;
             std::atomic_flag flag;
+            CancellationGroup group;
             OptionalWrapper<std::vector<E>> errors;
         };
 
         const auto ctx = std::make_shared<Context>(static_cast<std::size_t>(std::ranges::distance(first, last)));
 
         for (std::size_t i{0}; first != last; ++first, ++i) {
+            ctx->group.add(*first);
             (*first).setCallback([=](std::expected<T, E> &&result) {
                 if (!result) {
                     ctx->errors[i] = std::move(result).error();
@@ -1266,10 +2290,14 @@ namespace zero::async::promise {
                         ctx->promise.resolve();
                     else
                         ctx->promise.resolve(*std::move(result));
+
+                    ctx->group.cancel();
                 }
             });
         }
 
+        CancellationGroup::bind(ctx);
+
         return ctx->promise.getFuture();
     }
 
@@ -1297,12 +2325,14 @@ namespace zero::async::promise {
             promise;
             std::atomic<std::size_t> count{sizeof...(Ts)};
             std::atomic_flag flag;
+            CancellationGroup group;
             OptionalWrapper<std::array<E, sizeof...(Ts)>> errors;
         };
 
         const auto ctx = std::make_shared<Context>();
 
         ([&] {
+            ctx->group.add(futures);
             futures.setCallback([=](std::expected<Ts, E> &&result) {
                 if (!result) {
                     std::get<Is>(ctx->errors) = std::move(result).error();
@@ -1324,10 +2354,14 @@ namespace zero::async::promise {
                     else {
                         ctx->promise.resolve(*std::move(result));
                     }
+
+                    ctx->group.cancel();
                 }
             });
         }(), ...);
 
+        CancellationGroup::bind(ctx);
+
         return ctx->promise.getFuture();
     }
 
@@ -1348,15 +2382,19 @@ namespace zero::async::promise {
         struct Context {
             Promise<T, E> promise;
             std::atomic_flag flag;
+            CancellationGroup group;
         };
 
         const auto ctx = std::make_shared<Context>();
 
         while (first != last) {
+            ctx->group.add(*first);
             (*first++).setCallback([=](std::expected<T, E> &&result) {
                 if (!result) {
-                    if (!ctx->flag.test_and_set())
+                    if (!ctx->flag.test_and_set()) {
                         ctx->promise.reject(std::move(result).error());
+                        ctx->group.cancel();
+                    }
 
                     return;
                 }
@@ -1366,10 +2404,14 @@ namespace zero::async::promise {
                         ctx->promise.resolve();
                     else
                         ctx->promise.resolve(*std::move(result));
+
+                    ctx->group.cancel();
                 }
             });
         }
 
+        CancellationGroup::bind(ctx);
+
         return ctx->promise.getFuture();
     }
 
@@ -1388,15 +2430,19 @@ namespace zero::async::promise {
         struct Context {
             Promise<std::conditional_t<Same, meta::FirstElement<Ts...>, std::any>, E> promise;
             std::atomic_flag flag;
+            CancellationGroup group;
         };
 
         const auto ctx = std::make_shared<Context>();
 
         ([&] {
+            ctx->group.add(futures);
             futures.setCallback([=](std::expected<Ts, E> &&result) {
                 if (!result) {
-                    if (!ctx->flag.test_and_set())
+                    if (!ctx->flag.test_and_set()) {
                         ctx->promise.reject(std::move(result).error());
+                        ctx->group.cancel();
+                    }
 
                     return;
                 }
@@ -1411,12 +2457,31 @@ namespace zero::async::promise {
                     else {
                         ctx->promise.resolve(*std::move(result));
                     }
+
+                    ctx->group.cancel();
                 }
             });
         }(), ...);
 
+        CancellationGroup::bind(ctx);
+
         return ctx->promise.getFuture();
     }
+
+    template<typename E = std::exception_ptr>
+    SemiFuture<void, E>
+    sleep(const std::chrono::milliseconds duration, std::shared_ptr<TimerWheel> wheel = TimerWheel::instance()) {
+        Promise<void, E> promise;
+        auto future = promise.getFuture();
+
+        wheel->add(duration, [promise = std::move(promise)]() mutable {
+            promise.resolve();
+        });
+
+        return future;
+    }
 }
 
+Z_DECLARE_ERROR_CODES(zero::async::promise::TimeoutError, zero::async::promise::TaskError)
+
 #endif //ZERO_ASYNC_PROMISE_H
@@ -0,0 +1,76 @@
+#ifndef ZERO_ASYNC_TIMER_H
+#define ZERO_ASYNC_TIMER_H
+
+#include <array>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <condition_variable>
+#include <zero/function.h>
+
+namespace zero::async {
+    // Hierarchical timing wheel driven by a single thread, adding and cancelling a timer is O(1) regardless of how many
+    // are pending. Callbacks run on the wheel thread and should hand off any heavy work.
+    class TimerWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimerID = std::uint64_t;
+
+        static constexpr std::size_t Levels = 4;
+        static constexpr std::size_t SlotBits = 6;
+        static constexpr std::size_t Slots = 1 << SlotBits;
+
+    private:
+        struct Node {
+            TimerID id{};
+            std::uint64_t deadline{};
+            SmallFunction<void()> callback;
+            std::size_t level{};
+            std::size_t slot{};
+            Node *prev{};
+            Node *next{};
+        };
+
+    public:
+        explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds{1});
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+        ~TimerWheel();
+
+        static std::shared_ptr<TimerWheel> instance();
+
+    private:
+        void dispatch();
+        void link(Node &node);
+        void unlink(Node &node);
+        void advance(std::vector<SmallFunction<void()>> &expired);
+        [[nodiscard]] std::uint64_t elapsed() const;
+        [[nodiscard]] std::uint64_t next() const;
+
+    public:
+        TimerID add(std::chrono::milliseconds delay, SmallFunction<void()> callback);
+        bool cancel(TimerID id);
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] std::chrono::milliseconds tick() const;
+
+    private:
+        bool mStopped;
+        std::chrono::milliseconds mTick;
+        Clock::time_point mEpoch;
+        std::uint64_t mCurrent;
+        std::uint64_t mWake;
+        TimerID mCounter;
+        std::array<std::array<Node *, Slots>, Levels> mSlots;
+        std::unordered_map<TimerID, Node> mTimers;
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::thread mThread;
+    };
+}
+
+#endif //ZERO_ASYNC_TIMER_H
@@ -0,0 +1,12 @@
+#ifndef ZERO_ATOMIC_CACHE_LINE_H
+#define ZERO_ATOMIC_CACHE_LINE_H
+
+#include <cstddef>
+
+namespace zero::atomic {
+    // `std::hardware_destructive_interference_size` changes with compiler flags and is not provided everywhere, 128
+    // bytes also keeps apart the line pairs that x86 prefetches together.
+    inline constexpr std::size_t CacheLineSize = 128;
+}
+
+#endif //ZERO_ATOMIC_CACHE_LINE_H
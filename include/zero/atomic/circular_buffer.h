@@ -1,99 +1,338 @@
 #ifndef ZERO_ATOMIC_CIRCULAR_BUFFER_H
 #define ZERO_ATOMIC_CIRCULAR_BUFFER_H
 
-#include <limits>
 #include <cstddef>
 #include <atomic>
+#include <array>
+#include <bit>
+#include <span>
 #include <memory>
+#include <thread>
+#include <functional>
 #include <optional>
+#include <algorithm>
 #include <cassert>
+#include <concepts>
+#include <exception>
+#include <zero/atomic/cache_line.h>
 
 namespace zero::atomic {
-    template<typename T>
+    // Each slot carries a sequence next to its value instead of sharing a packed state array, twice the position it
+    // expects next, plus one once it holds a value. Producers and consumers only touch the slot they claimed and their
+    // own padded index, so threads working on different slots do not contend for the same cache line.
+    // Positions are mapped to slots with a mask instead of a division when the number of slots is a power of two. With a
+    // fixed `Slots` the slots are stored inline, and `Slots` is the number of values the ring holds. A dynamic ring is
+    // constructed with a `capacity` one larger than that, as a ring telling full from empty by its indices would be, so
+    // it is masked when `capacity - 1` is a power of two, as it is for a channel of power-of-two capacity. Either way
+    // `capacity()` includes the slot kept back.
+    // Slots are raw storage, a value is constructed in place by `commit` or `produce` and destroyed by `release` or
+    // `consume`, so `T` needs no default constructor and a large buffer costs nothing until it is used.
+    // A slot whose value failed to construct is still published, marked empty, and consumers skip it, so that an
+    // exception thrown while committing never leaves a claimed slot behind for consumers to wait on.
+    template<typename T, std::size_t Slots = std::dynamic_extent>
     class CircularBuffer {
-        enum class State {
-            Idle,
-            Putting,
-            Valid,
-            Taking
+        static_assert(Slots == std::dynamic_extent || Slots > 0);
+
+        struct Slot {
+            std::atomic<std::size_t> sequence;
+            // only written by the producer before publishing and by the consumer before handing the slot back
+            bool empty;
+            alignas(T) std::byte storage[sizeof(T)];
         };
 
+        using Storage = std::conditional_t<
+            Slots == std::dynamic_extent,
+            std::unique_ptr<Slot[]>,
+            std::array<Slot, Slots == std::dynamic_extent ? 0 : Slots>
+        >;
+
     public:
-        explicit CircularBuffer(const std::size_t capacity)
-            : mModulo{std::numeric_limits<std::size_t>::max() / capacity * capacity}, mCapacity{capacity},
-              mBuffer{std::make_unique<T[]>(capacity)}, mState{std::make_unique<std::atomic<State>[]>(capacity)} {
+        CircularBuffer() requires (Slots != std::dynamic_extent)
+            : mCapacity{Slots + 1}, mLength{Slots}, mMasked{std::has_single_bit(Slots)} {
+            initialize();
+        }
+
+        explicit CircularBuffer(const std::size_t capacity) requires (Slots == std::dynamic_extent)
+            : mCapacity{capacity}, mLength{capacity - 1}, mMasked{std::has_single_bit(capacity - 1)},
+              mSlots{std::make_unique_for_overwrite<Slot[]>(capacity - 1)} {
             assert(mCapacity > 1);
+            initialize();
+        }
+
+        ~CircularBuffer() {
+            // values still in the ring, including acquired ones that were never released, have an odd sequence
+            for (std::size_t i{0}; i < mLength; ++i) {
+                if (mSlots[i].sequence.load(std::memory_order_relaxed) % 2 == 1 && !mSlots[i].empty)
+                    std::destroy_at(value(i));
+            }
         }
 
         std::optional<std::size_t> reserve() {
-            auto index = mTail.load();
+            std::size_t retries{0};
+            return reserve(retries);
+        }
 
-            do {
-                if (full())
+        // Adds to `retries` each time another producer got to the slot first and the claim had to start over.
+        std::optional<std::size_t> reserve(std::size_t &retries) {
+            auto position = mTail.load(std::memory_order_relaxed);
+
+            while (true) {
+                const auto index = slot(position);
+                const auto delta = distance(mSlots[index].sequence.load(std::memory_order_acquire), position * 2);
+
+                // the slot still holds the value from the previous lap
+                if (delta < 0)
                     return std::nullopt;
-            }
-            while (!mTail.compare_exchange_weak(index, (index + 1) % mModulo));
 
-            index %= mCapacity;
+                if (delta > 0) {
+                    ++retries;
+                    position = mTail.load(std::memory_order_relaxed);
+                    continue;
+                }
 
-            while (true) {
-                if (auto expected = State::Idle; mState[index].compare_exchange_weak(expected, State::Putting))
+                if (mTail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
                     return index;
+
+                ++retries;
             }
         }
 
-        void commit(const std::size_t index) {
-            mState[index] = State::Valid;
+        // Constructs the value of a reserved slot from `args` and hands it to consumers. If the constructor throws, the
+        // slot is handed on empty before the exception propagates.
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        void commit(const std::size_t index, Args &&... args) {
+            try {
+                new(mSlots[index].storage) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                mSlots[index].empty = true;
+                publish(index);
+                throw;
+            }
+
+            publish(index);
         }
 
         std::optional<std::size_t> acquire() {
-            auto index = mHead.load();
+            std::size_t retries{0};
+            return acquire(retries);
+        }
 
-            do {
-                if (empty())
+        // Adds to `retries` each time another consumer got to the slot first and the claim had to start over.
+        std::optional<std::size_t> acquire(std::size_t &retries) {
+            auto position = mHead.load(std::memory_order_relaxed);
+
+            while (true) {
+                const auto index = slot(position);
+                const auto delta = distance(mSlots[index].sequence.load(std::memory_order_acquire), position * 2 + 1);
+
+                if (delta < 0)
                     return std::nullopt;
-            }
-            while (!mHead.compare_exchange_weak(index, (index + 1) % mModulo));
 
-            index %= mCapacity;
+                if (delta > 0) {
+                    ++retries;
+                    position = mHead.load(std::memory_order_relaxed);
+                    continue;
+                }
 
-            while (true) {
-                if (auto expected = State::Valid; mState[index].compare_exchange_weak(expected, State::Taking))
+                if (!mHead.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    ++retries;
+                    continue;
+                }
+
+                if (!mSlots[index].empty)
                     return index;
+
+                // a producer failed to construct this value
+                recycle(index);
+                position = mHead.load(std::memory_order_relaxed);
             }
         }
 
+        // Destroys the value of an acquired slot and hands the slot back to producers.
         void release(const std::size_t index) {
-            mState[index] = State::Idle;
+            std::destroy_at(value(index));
+            recycle(index);
         }
 
+        // Claims up to `n` consecutive slots with a single CAS and fills them in order, once the previous reader of a
+        // slot has released it, its value is constructed from what `f` returns and committed right after. Waiting on
+        // one slot at a time never holds a claimed slot hostage, so batches cannot deadlock against each other.
+        // Once `f` or the constructor throws, the rest of the batch is handed on empty and the exception rethrown.
+        template<typename F>
+        std::size_t produce(const std::size_t n, F &&f) {
+            auto tail = mTail.load(std::memory_order_relaxed);
+            std::size_t count;
+
+            do {
+                // the head may have moved past a stale tail, in which case the CAS fails and the tail is reloaded
+                const auto head = mHead.load(std::memory_order_relaxed);
+                count = std::min(n, mLength - std::min(used(head, tail), mLength));
+
+                if (count == 0)
+                    return 0;
+            }
+            while (!mTail.compare_exchange_weak(tail, tail + count, std::memory_order_relaxed));
+
+            std::exception_ptr exception;
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto index = slot(tail + i);
+
+                while (mSlots[index].sequence.load(std::memory_order_acquire) != (tail + i) * 2) {
+                    // the previous reader may have been preempted mid-batch, let it run instead of burning our slice
+                    std::this_thread::yield();
+                }
+
+                if (!exception) {
+                    try {
+                        new(mSlots[index].storage) T(std::invoke(f));
+                    }
+                    catch (...) {
+                        exception = std::current_exception();
+                    }
+                }
+
+                if (exception)
+                    mSlots[index].empty = true;
+
+                publish(index);
+            }
+
+            if (exception)
+                std::rethrow_exception(exception);
+
+            return count;
+        }
+
+        // The counterpart of `produce`, `f` is invoked on the value of each of up to `n` slots before it is released.
+        // Returns the number of values passed to `f`, which leaves out empty slots. Should `f` throw, the values left
+        // in the batch are released unseen before the exception propagates.
+        template<typename F>
+        std::size_t consume(const std::size_t n, F &&f) {
+            auto head = mHead.load(std::memory_order_relaxed);
+            std::size_t count;
+
+            do {
+                count = std::min(n, used(head, mTail.load(std::memory_order_relaxed)));
+
+                if (count == 0)
+                    return 0;
+            }
+            while (!mHead.compare_exchange_weak(head, head + count, std::memory_order_relaxed));
+
+            std::size_t consumed{0};
+            std::exception_ptr exception;
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto index = slot(head + i);
+
+                while (mSlots[index].sequence.load(std::memory_order_acquire) != (head + i) * 2 + 1)
+                    std::this_thread::yield();
+
+                if (mSlots[index].empty) {
+                    recycle(index);
+                    continue;
+                }
+
+                if (!exception) {
+                    try {
+                        std::invoke(f, *value(index));
+                        ++consumed;
+                    }
+                    catch (...) {
+                        exception = std::current_exception();
+                    }
+                }
+
+                release(index);
+            }
+
+            if (exception)
+                std::rethrow_exception(exception);
+
+            return consumed;
+        }
+
+        // Only valid between `acquire` and `release`.
         T &operator[](const std::size_t index) {
-            return mBuffer[index];
+            return *value(index);
         }
 
         [[nodiscard]] std::size_t size() const {
-            return (mTail % mCapacity + mCapacity - mHead % mCapacity) % mCapacity;
+            const auto head = mHead.load(std::memory_order_relaxed);
+            return std::min(used(head, mTail.load(std::memory_order_relaxed)), mLength);
         }
 
         [[nodiscard]] std::size_t capacity() const {
             return mCapacity;
         }
 
+        // Whether `acquire()` would find nothing to take.
         [[nodiscard]] bool empty() const {
-            return mHead == mTail;
+            const auto position = mHead.load(std::memory_order_relaxed);
+            return distance(mSlots[slot(position)].sequence.load(std::memory_order_acquire), position * 2 + 1) < 0;
         }
 
+        // Whether `reserve()` would find no free slot.
         [[nodiscard]] bool full() const {
-            return (mTail + 1) % mCapacity == mHead % mCapacity;
+            const auto position = mTail.load(std::memory_order_relaxed);
+            return distance(mSlots[slot(position)].sequence.load(std::memory_order_acquire), position * 2) < 0;
         }
 
     private:
-        std::size_t mModulo;
+        void initialize() {
+            for (std::size_t i{0}; i < mLength; ++i) {
+                mSlots[i].sequence.store(i * 2, std::memory_order_relaxed);
+                mSlots[i].empty = false;
+            }
+        }
+
+        T *value(const std::size_t index) {
+            return reinterpret_cast<T *>(mSlots[index].storage);
+        }
+
+        void publish(const std::size_t index) {
+            auto &sequence = mSlots[index].sequence;
+            sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // Hands an acquired slot whose value is gone back to producers.
+        void recycle(const std::size_t index) {
+            mSlots[index].empty = false;
+
+            auto &sequence = mSlots[index].sequence;
+            sequence.store(sequence.load(std::memory_order_relaxed) - 1 + mLength * 2, std::memory_order_release);
+        }
+
+        [[nodiscard]] std::size_t slot(const std::size_t position) const {
+            if constexpr (Slots != std::dynamic_extent) {
+                if constexpr (std::has_single_bit(Slots))
+                    return position & (Slots - 1);
+                else
+                    return position % Slots;
+            }
+            else {
+                return mMasked ? position & (mLength - 1) : position % mLength;
+            }
+        }
+
+        static std::ptrdiff_t distance(const std::size_t sequence, const std::size_t expected) {
+            return static_cast<std::ptrdiff_t>(sequence - expected);
+        }
+
+        static std::size_t used(const std::size_t head, const std::size_t tail) {
+            return distance(tail, head) < 0 ? 0 : tail - head;
+        }
+
+        // one slot is kept back to match the capacity of a ring that tells full from empty by its indices
         std::size_t mCapacity;
-        std::atomic<std::size_t> mHead;
-        std::atomic<std::size_t> mTail;
-        std::unique_ptr<T[]> mBuffer;
-        std::unique_ptr<std::atomic<State>[]> mState;
+        std::size_t mLength;
+        bool mMasked;
+        Storage mSlots;
+        alignas(CacheLineSize) std::atomic<std::size_t> mHead{0};
+        alignas(CacheLineSize) std::atomic<std::size_t> mTail{0};
     };
 }
 
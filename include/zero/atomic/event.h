@@ -2,6 +2,7 @@
 #define ZERO_ATOMIC_EVENT_H
 
 #include <atomic>
+#include <cstdint>
 #include <chrono>
 #include <optional>
 #include <expected>
@@ -29,6 +30,33 @@ namespace zero::atomic {
         std::atomic<Value> mState;
         std::atomic<int> mWaiterCount;
     };
+
+    // Lets threads sleep until a condition they observe without a lock may have changed. A waiter registers with
+    // `prepare()`, re-checks its condition, then either `cancel()`s or `wait()`s with the returned key; a `notify()`
+    // made after the condition changed is never missed, and costs a single load while nobody is waiting.
+    class EventCount {
+        // unsigned, so that the epoch wraps around instead of overflowing, and as wide as a futex
+#ifdef __APPLE__
+        using Value = std::uint64_t;
+#else
+        using Value = std::uint32_t;
+#endif
+
+    public:
+        using Key = Value;
+
+        EventCount();
+
+        Key prepare();
+        void cancel();
+        std::expected<void, std::error_code> wait(Key key, std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+        void notify();
+
+    private:
+        std::atomic<Value> mEpoch;
+        std::atomic<int> mWaiterCount;
+    };
 }
 
 #endif //ZERO_ATOMIC_EVENT_H
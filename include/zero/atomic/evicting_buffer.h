@@ -0,0 +1,162 @@
+#ifndef ZERO_ATOMIC_EVICTING_BUFFER_H
+#define ZERO_ATOMIC_EVICTING_BUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <zero/atomic/cache_line.h>
+
+namespace zero::atomic {
+    // Ring buffer for exactly one producer and one consumer thread, whose producer may make room by destroying the
+    // oldest element. Indices are positions that only grow, the head keeps a busy bit below its position: the consumer
+    // sets it with one CAS per batch while it takes elements, and the producer only evicts through a CAS on a head that
+    // is not busy, so neither of them can touch an element the other one is working on. Pushing into a ring with room
+    // is a plain store, as in `SPSCBuffer`.
+    template<typename T>
+    class EvictingBuffer {
+        static constexpr std::size_t Busy = 1;
+
+        struct Slot {
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+    public:
+        explicit EvictingBuffer(const std::size_t capacity)
+            : mCapacity{capacity}, mSlots{std::make_unique_for_overwrite<Slot[]>(capacity)} {
+            assert(mCapacity > 0);
+        }
+
+        EvictingBuffer(const EvictingBuffer &) = delete;
+        EvictingBuffer &operator=(const EvictingBuffer &) = delete;
+
+        ~EvictingBuffer() {
+            for (auto position = mHead.load(std::memory_order_relaxed) >> 1;
+                 position != mTail.load(std::memory_order_relaxed); ++position)
+                std::destroy_at(value(position));
+        }
+
+        // Constructs an element from `args` if there is room, they are left untouched otherwise.
+        template<typename... Args>
+        bool push(Args &&... args) {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+
+            if (tail - mCachedHead == mCapacity) {
+                mCachedHead = mHead.load(std::memory_order_acquire) >> 1;
+
+                if (tail - mCachedHead == mCapacity)
+                    return false;
+            }
+
+            new(mSlots[tail % mCapacity].storage) T(std::forward<Args>(args)...);
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Always constructs an element, destroying the oldest one first when the ring is full. Returns whether it had to.
+        // Should the constructor throw, the oldest element is gone all the same.
+        template<typename... Args>
+        bool pushEvicting(Args &&... args) {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+            auto evicted = false;
+
+            while (tail - mCachedHead == mCapacity) {
+                auto head = mHead.load(std::memory_order_acquire);
+
+                if (tail - (head >> 1) < mCapacity) {
+                    mCachedHead = head >> 1;
+                    break;
+                }
+
+                // the consumer is taking elements right now, which frees room anyway
+                if (head & Busy) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (!mHead.compare_exchange_weak(head, head + 2, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    continue;
+
+                std::destroy_at(value(head >> 1));
+                mCachedHead = (head >> 1) + 1;
+                evicted = true;
+            }
+
+            new(mSlots[tail % mCapacity].storage) T(std::forward<Args>(args)...);
+            mTail.store(tail + 1, std::memory_order_release);
+            return evicted;
+        }
+
+        // Takes up to `n` elements, oldest first, and hands them back with a single store. Should `f` throw, the element
+        // it threw on stays in the ring and the batch ends there.
+        template<typename F>
+        std::size_t consume(const std::size_t n, F &&f) {
+            auto head = mHead.load(std::memory_order_relaxed);
+
+            while (true) {
+                assert(!(head & Busy));
+
+                if (head >> 1 == mTail.load(std::memory_order_acquire))
+                    return 0;
+
+                if (mHead.compare_exchange_weak(head, head | Busy, std::memory_order_acquire, std::memory_order_relaxed))
+                    break;
+            }
+
+            const auto position = head >> 1;
+            const auto count = std::min(n, mTail.load(std::memory_order_acquire) - position);
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto element = value(position + i);
+
+                try {
+                    std::invoke(f, *element);
+                }
+                catch (...) {
+                    // clears the busy bit, or the producer could never evict again
+                    mHead.store((position + i) << 1, std::memory_order_release);
+                    throw;
+                }
+
+                std::destroy_at(element);
+            }
+
+            mHead.store((position + count) << 1, std::memory_order_release);
+            return count;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            // the head first, so that it is never ahead of the tail
+            const auto head = mHead.load(std::memory_order_acquire) >> 1;
+            return mTail.load(std::memory_order_acquire) - head;
+        }
+
+        [[nodiscard]] std::size_t capacity() const {
+            return mCapacity;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        [[nodiscard]] bool full() const {
+            return size() == mCapacity;
+        }
+
+    private:
+        T *value(const std::size_t position) {
+            return reinterpret_cast<T *>(mSlots[position % mCapacity].storage);
+        }
+
+        // the consumer writes the first line and the producer only CASes it to evict, the producer owns the second
+        alignas(CacheLineSize) std::atomic<std::size_t> mHead{0};
+        alignas(CacheLineSize) std::atomic<std::size_t> mTail{0};
+        std::size_t mCachedHead{0};
+        alignas(CacheLineSize) std::size_t mCapacity;
+        std::unique_ptr<Slot[]> mSlots;
+    };
+}
+
+#endif //ZERO_ATOMIC_EVICTING_BUFFER_H
@@ -0,0 +1,408 @@
+#ifndef ZERO_ATOMIC_SEGMENTED_BUFFER_H
+#define ZERO_ATOMIC_SEGMENTED_BUFFER_H
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <concepts>
+#include <optional>
+#include <exception>
+#include <functional>
+
+namespace zero::atomic {
+    // Unbounded buffer made of fixed-size segments linked into a list. The producer side appends a segment whenever
+    // the last one fills up, and segments the consumer side has moved past go back to a free-list, in order, once all
+    // of their slots have been released. Only a few spare segments are kept, so memory grows with a burst and is given
+    // back after it. Claiming slots takes a short lock, values are constructed and destroyed outside of it, and `size()`
+    // and `empty()` only load the counters of claimed and taken slots, so polling them never touches the lock.
+    // Shares the reserve/commit, acquire/release interface of `CircularBuffer`, with the slot itself as the index.
+    // As there, a slot whose value failed to construct is marked ready but empty, and skipped by consumers.
+    template<typename T, std::size_t SegmentSize = 32>
+    class SegmentedBuffer {
+        static_assert(SegmentSize > 0);
+
+        struct Segment;
+
+        struct Slot {
+            Segment *segment;
+            std::atomic<bool> ready;
+            bool empty;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        struct Segment {
+            std::atomic<std::size_t> pending;
+            Segment *next;
+            std::array<Slot, SegmentSize> slots;
+        };
+
+        struct Cursor {
+            Segment *segment;
+            std::size_t offset;
+        };
+
+        static constexpr std::size_t MaxSpareSegments = 2;
+
+    public:
+        // `onSoftLimit` is invoked by the producer that grows the buffer past `softLimit` elements, with the size it
+        // observed. It is only invoked again once the size has dropped back to the limit. It runs after the lock is
+        // released, so consumers may already have taken elements and the size it is passed can be stale.
+        explicit SegmentedBuffer(
+            const std::size_t softLimit = std::numeric_limits<std::size_t>::max(),
+            std::function<void(std::size_t)> onSoftLimit = nullptr
+        ) : mSoftLimit{softLimit}, mOnSoftLimit{std::move(onSoftLimit)} {
+            const auto segment = allocate();
+            mOldest = segment;
+            mHead = {segment, 0};
+            mTail = {segment, 0};
+        }
+
+        SegmentedBuffer(const SegmentedBuffer &) = delete;
+        SegmentedBuffer &operator=(const SegmentedBuffer &) = delete;
+
+        ~SegmentedBuffer() {
+            while (mOldest) {
+                for (auto &slot: mOldest->slots) {
+                    if (slot.ready && !slot.empty)
+                        std::destroy_at(value(&slot));
+                }
+
+                delete std::exchange(mOldest, mOldest->next);
+            }
+
+            while (mFree)
+                delete std::exchange(mFree, mFree->next);
+        }
+
+        std::optional<Slot *> reserve() {
+            Slot *slot;
+            std::optional<std::size_t> exceeded;
+
+            {
+                std::lock_guard guard{mMutex};
+                slot = claim();
+                exceeded = grown(1);
+            }
+
+            if (exceeded)
+                mOnSoftLimit(*exceeded);
+
+            return slot;
+        }
+
+        // If the constructor throws, the slot is handed on empty before the exception propagates.
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        void commit(Slot *slot, Args &&... args) {
+            try {
+                new(slot->storage) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                slot->empty = true;
+                slot->ready.store(true, std::memory_order_release);
+                throw;
+            }
+
+            slot->ready.store(true, std::memory_order_release);
+        }
+
+        std::optional<Slot *> acquire() {
+            while (true) {
+                Slot *slot;
+
+                {
+                    std::lock_guard guard{mMutex};
+
+                    if (!take(1))
+                        return std::nullopt;
+
+                    slot = &mHead.segment->slots[mHead.offset - 1];
+                }
+
+                if (!slot->empty)
+                    return slot;
+
+                recycle(slot);
+            }
+        }
+
+        void release(Slot *slot) {
+            std::destroy_at(value(slot));
+            recycle(slot);
+        }
+
+        // Claims `n` slots under a single lock and fills them in order, each value is constructed from what `f`
+        // returns. Never fails short, since the buffer is unbounded. Once `f` or the constructor throws, the rest of the
+        // batch is handed on empty and the exception rethrown.
+        template<typename F>
+        std::size_t produce(const std::size_t n, F &&f) {
+            if (n == 0)
+                return 0;
+
+            Cursor cursor;
+            std::optional<std::size_t> exceeded;
+
+            {
+                std::lock_guard guard{mMutex};
+
+                claim();
+                cursor = {mTail.segment, mTail.offset - 1};
+
+                for (std::size_t i{1}; i < n; ++i)
+                    claim();
+
+                exceeded = grown(n);
+            }
+
+            if (exceeded)
+                mOnSoftLimit(*exceeded);
+
+            std::exception_ptr exception;
+
+            for (std::size_t i{0}; i < n; ++i) {
+                const auto slot = &cursor.segment->slots[cursor.offset];
+
+                // once the slot is committed its segment may be consumed and recycled, so move on before that
+                if (++cursor.offset == SegmentSize && i + 1 < n)
+                    cursor = {cursor.segment->next, 0};
+
+                if (!exception) {
+                    try {
+                        new(slot->storage) T(std::invoke(f));
+                    }
+                    catch (...) {
+                        exception = std::current_exception();
+                    }
+                }
+
+                if (exception)
+                    slot->empty = true;
+
+                slot->ready.store(true, std::memory_order_release);
+            }
+
+            if (exception)
+                std::rethrow_exception(exception);
+
+            return n;
+        }
+
+        // The counterpart of `produce`, `f` is invoked on the value of each of up to `n` slots before it is released.
+        // Returns the number of values passed to `f`, which leaves out empty slots. Should `f` throw, the values left
+        // in the batch are released unseen before the exception propagates.
+        template<typename F>
+        std::size_t consume(const std::size_t n, F &&f) {
+            Cursor cursor{};
+            std::size_t count;
+
+            {
+                std::lock_guard guard{mMutex};
+
+                if (const auto front = peek(); front)
+                    cursor = *front;
+
+                count = take(n);
+            }
+
+            std::size_t consumed{0};
+            std::exception_ptr exception;
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto slot = &cursor.segment->slots[cursor.offset];
+
+                if (++cursor.offset == SegmentSize && i + 1 < count)
+                    cursor = {cursor.segment->next, 0};
+
+                if (slot->empty) {
+                    recycle(slot);
+                    continue;
+                }
+
+                if (!exception) {
+                    try {
+                        std::invoke(f, *value(slot));
+                        ++consumed;
+                    }
+                    catch (...) {
+                        exception = std::current_exception();
+                    }
+                }
+
+                release(slot);
+            }
+
+            if (exception)
+                std::rethrow_exception(exception);
+
+            return consumed;
+        }
+
+        // Only valid between `acquire` and `release`.
+        T &operator[](Slot *slot) {
+            return *value(slot);
+        }
+
+        // Counts claimed slots whose values may not be committed yet.
+        [[nodiscard]] std::size_t size() const {
+            // taking never runs ahead of claiming, and the acquire makes the claims it counted visible
+            const auto popped = mPopped.load(std::memory_order_acquire);
+            return mPushed.load(std::memory_order_relaxed) - popped;
+        }
+
+        [[nodiscard]] std::size_t capacity() const {
+            return std::numeric_limits<std::size_t>::max();
+        }
+
+        // Whether no slot is claimed and left to take. A slot that is claimed but not yet committed makes the buffer
+        // non-empty, while `acquire()` does not return it until it is committed.
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        [[nodiscard]] bool full() const {
+            return false;
+        }
+
+    private:
+        static T *value(Slot *slot) {
+            return reinterpret_cast<T *>(slot->storage);
+        }
+
+        // Hands a taken slot whose value is gone back, recycling its segment once that was the last one pending.
+        void recycle(Slot *slot) {
+            slot->empty = false;
+            slot->ready.store(false, std::memory_order_relaxed);
+
+            if (slot->segment->pending.fetch_sub(1, std::memory_order_acq_rel) > 1)
+                return;
+
+            std::lock_guard guard{mMutex};
+            reclaim();
+        }
+
+        Segment *allocate() {
+            Segment *segment;
+
+            if (mFree) {
+                segment = std::exchange(mFree, mFree->next);
+                --mSpareCount;
+            }
+            else {
+                segment = new Segment;
+
+                for (auto &slot: segment->slots) {
+                    slot.segment = segment;
+                    slot.empty = false;
+                }
+            }
+
+            segment->pending.store(SegmentSize, std::memory_order_relaxed);
+            segment->next = nullptr;
+            return segment;
+        }
+
+        Slot *claim() {
+            if (mTail.offset == SegmentSize) {
+                const auto segment = allocate();
+                mTail.segment->next = segment;
+                mTail = {segment, 0};
+            }
+
+            return &mTail.segment->slots[mTail.offset++];
+        }
+
+        std::optional<std::size_t> grown(const std::size_t n) {
+            const auto size = mPushed.fetch_add(n, std::memory_order_relaxed) + n -
+                mPopped.load(std::memory_order_relaxed);
+
+            if (!mOnSoftLimit || size <= mSoftLimit || mExceeded)
+                return std::nullopt;
+
+            mExceeded = true;
+            return size;
+        }
+
+        // The position of the next committed value, skipping over the end of a segment.
+        [[nodiscard]] std::optional<Cursor> peek() const {
+            auto cursor = mHead;
+
+            if (cursor.offset == SegmentSize) {
+                if (!cursor.segment->next)
+                    return std::nullopt;
+
+                cursor = {cursor.segment->next, 0};
+            }
+
+            if (cursor.segment == mTail.segment && cursor.offset == mTail.offset)
+                return std::nullopt;
+
+            if (!cursor.segment->slots[cursor.offset].ready.load(std::memory_order_acquire))
+                return std::nullopt;
+
+            return cursor;
+        }
+
+        // Moves the head past up to `n` consecutive committed values.
+        std::size_t take(const std::size_t n) {
+            std::size_t count{0};
+
+            while (count < n) {
+                const auto cursor = peek();
+
+                if (!cursor)
+                    break;
+
+                const auto advanced = cursor->segment != mHead.segment;
+                mHead = {cursor->segment, cursor->offset + 1};
+                ++count;
+
+                if (advanced)
+                    reclaim();
+            }
+
+            if (count == 0)
+                return 0;
+
+            const auto size = mPushed.load(std::memory_order_relaxed) -
+                mPopped.fetch_add(count, std::memory_order_release) - count;
+
+            if (size <= mSoftLimit)
+                mExceeded = false;
+
+            return count;
+        }
+
+        // Recycles fully released segments behind the head, oldest first.
+        void reclaim() {
+            while (mOldest != mHead.segment && mOldest->pending.load(std::memory_order_acquire) == 0) {
+                const auto segment = std::exchange(mOldest, mOldest->next);
+
+                if (mSpareCount == MaxSpareSegments) {
+                    delete segment;
+                    continue;
+                }
+
+                segment->next = mFree;
+                mFree = segment;
+                ++mSpareCount;
+            }
+        }
+
+        std::size_t mSoftLimit;
+        std::function<void(std::size_t)> mOnSoftLimit;
+        bool mExceeded{false};
+        std::mutex mMutex;
+        Cursor mHead;
+        Cursor mTail;
+        Segment *mOldest;
+        Segment *mFree{nullptr};
+        std::size_t mSpareCount{0};
+        std::atomic<std::size_t> mPushed{0};
+        std::atomic<std::size_t> mPopped{0};
+    };
+}
+
+#endif //ZERO_ATOMIC_SEGMENTED_BUFFER_H
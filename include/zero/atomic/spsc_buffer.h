@@ -0,0 +1,187 @@
+#ifndef ZERO_ATOMIC_SPSC_BUFFER_H
+#define ZERO_ATOMIC_SPSC_BUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <cassert>
+#include <concepts>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <zero/atomic/cache_line.h>
+
+namespace zero::atomic {
+    // Ring buffer for exactly one producer and one consumer thread. Each side owns its index and only reads the other
+    // one, with a cached copy, when the ring looks full or empty, so no slot state or CAS is needed. Shares the
+    // reserve/commit, acquire/release interface of `CircularBuffer`, including its raw slot storage. An index is only
+    // published after its value is constructed and only handed back after it is destroyed, so a throwing constructor,
+    // `f` of `produce` or `f` of `consume` leaves the ring consistent.
+    template<typename T>
+    class SPSCBuffer {
+        struct Slot {
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+    public:
+        explicit SPSCBuffer(const std::size_t capacity)
+            : mCapacity{capacity}, mSlots{std::make_unique_for_overwrite<Slot[]>(capacity)} {
+            assert(mCapacity > 1);
+        }
+
+        ~SPSCBuffer() {
+            for (auto index = mHead.load(std::memory_order_relaxed); index != mTail.load(std::memory_order_relaxed);
+                 index = next(index))
+                std::destroy_at(value(index));
+        }
+
+        std::optional<std::size_t> reserve() {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+
+            if (next(tail) == mCachedHead) {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+
+                if (next(tail) == mCachedHead)
+                    return std::nullopt;
+            }
+
+            return tail;
+        }
+
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        void commit(const std::size_t index, Args &&... args) {
+            new(mSlots[index].storage) T(std::forward<Args>(args)...);
+            mTail.store(next(index), std::memory_order_release);
+        }
+
+        std::optional<std::size_t> acquire() {
+            const auto head = mHead.load(std::memory_order_relaxed);
+
+            if (head == mCachedTail) {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+
+                if (head == mCachedTail)
+                    return std::nullopt;
+            }
+
+            return head;
+        }
+
+        void release(const std::size_t index) {
+            std::destroy_at(value(index));
+            mHead.store(next(index), std::memory_order_release);
+        }
+
+        // Fills up to `n` free slots and publishes them with a single store.
+        template<typename F>
+        std::size_t produce(const std::size_t n, F &&f) {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+            auto count = std::min(n, free(tail));
+
+            if (count < n) {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                count = std::min(n, free(tail));
+            }
+
+            for (std::size_t i{0}; i < count; ++i) {
+                try {
+                    new(mSlots[(tail + i) % mCapacity].storage) T(std::invoke(f));
+                }
+                catch (...) {
+                    // the values built so far are published, the slot that threw holds none
+                    if (i > 0)
+                        mTail.store((tail + i) % mCapacity, std::memory_order_release);
+
+                    throw;
+                }
+            }
+
+            if (count > 0)
+                mTail.store((tail + count) % mCapacity, std::memory_order_release);
+
+            return count;
+        }
+
+        // Drains up to `n` slots and hands them back with a single store.
+        template<typename F>
+        std::size_t consume(const std::size_t n, F &&f) {
+            const auto head = mHead.load(std::memory_order_relaxed);
+            auto count = std::min(n, available(head));
+
+            if (count < n) {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+                count = std::min(n, available(head));
+            }
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto element = value((head + i) % mCapacity);
+
+                try {
+                    std::invoke(f, *element);
+                }
+                catch (...) {
+                    // the value `f` threw on stays in the ring
+                    if (i > 0)
+                        mHead.store((head + i) % mCapacity, std::memory_order_release);
+
+                    throw;
+                }
+
+                std::destroy_at(element);
+            }
+
+            if (count > 0)
+                mHead.store((head + count) % mCapacity, std::memory_order_release);
+
+            return count;
+        }
+
+        T &operator[](const std::size_t index) {
+            return *value(index);
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return (mTail.load(std::memory_order_acquire) + mCapacity - mHead.load(std::memory_order_acquire)) %
+                mCapacity;
+        }
+
+        [[nodiscard]] std::size_t capacity() const {
+            return mCapacity;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool full() const {
+            return next(mTail.load(std::memory_order_acquire)) == mHead.load(std::memory_order_acquire);
+        }
+
+    private:
+        T *value(const std::size_t index) {
+            return reinterpret_cast<T *>(mSlots[index].storage);
+        }
+
+        [[nodiscard]] std::size_t next(const std::size_t index) const {
+            return index + 1 == mCapacity ? 0 : index + 1;
+        }
+
+        [[nodiscard]] std::size_t free(const std::size_t tail) const {
+            return (mCachedHead + mCapacity - tail - 1) % mCapacity;
+        }
+
+        [[nodiscard]] std::size_t available(const std::size_t head) const {
+            return (mCachedTail + mCapacity - head) % mCapacity;
+        }
+
+        // the consumer writes the first line, the producer the second, and neither writes the third
+        alignas(CacheLineSize) std::atomic<std::size_t> mHead{0};
+        std::size_t mCachedTail{0};
+        alignas(CacheLineSize) std::atomic<std::size_t> mTail{0};
+        std::size_t mCachedHead{0};
+        alignas(CacheLineSize) std::size_t mCapacity;
+        std::unique_ptr<Slot[]> mSlots;
+    };
+}
+
+#endif //ZERO_ATOMIC_SPSC_BUFFER_H
@@ -0,0 +1,148 @@
+#ifndef ZERO_ATOMIC_WORK_STEALING_DEQUE_H
+#define ZERO_ATOMIC_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <optional>
+#include <type_traits>
+
+namespace zero::atomic {
+    // Chase-Lev deque: the owner thread pushes and pops at the bottom, other threads steal from the top.
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class WorkStealingDeque {
+        class Array {
+        public:
+            explicit Array(const std::int64_t capacity)
+                : mMask{capacity - 1}, mElements{std::make_unique<std::atomic<T>[]>(capacity)} {
+                assert((capacity & (capacity - 1)) == 0);
+            }
+
+            [[nodiscard]] std::int64_t capacity() const {
+                return mMask + 1;
+            }
+
+            T get(const std::int64_t index) const {
+                return mElements[index & mMask].load(std::memory_order_relaxed);
+            }
+
+            void put(const std::int64_t index, const T element) {
+                mElements[index & mMask].store(element, std::memory_order_relaxed);
+            }
+
+        private:
+            std::int64_t mMask;
+            std::unique_ptr<std::atomic<T>[]> mElements;
+        };
+
+    public:
+        explicit WorkStealingDeque(const std::size_t capacity = 64) : mTop{0}, mBottom{0} {
+            assert(capacity > 0);
+            assert((capacity & (capacity - 1)) == 0);
+            mArrays.push_back(std::make_unique<Array>(static_cast<std::int64_t>(capacity)));
+            mArray = mArrays.back().get();
+        }
+
+        WorkStealingDeque(const WorkStealingDeque &) = delete;
+        WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+        void push(const T element) {
+            const auto bottom = mBottom.load(std::memory_order_relaxed);
+            const auto top = mTop.load(std::memory_order_acquire);
+            auto array = mArray.load(std::memory_order_relaxed);
+
+            if (bottom - top > array->capacity() - 1)
+                array = grow(array, top, bottom);
+
+            array->put(bottom, element);
+            // publishes the element, and whatever the owner wrote before pushing it, to a thief that acquires the
+            // bottom; a release store orders exactly like a release fence before a relaxed store here, but unlike a
+            // standalone fence it is understood by thread sanitizer
+            mBottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        std::optional<T> pop() {
+            const auto bottom = mBottom.load(std::memory_order_relaxed) - 1;
+            const auto array = mArray.load(std::memory_order_relaxed);
+
+            mBottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto top = mTop.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                mBottom.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            const auto element = array->get(bottom);
+
+            if (top < bottom)
+                return element;
+
+            const auto won = mTop.compare_exchange_strong(
+                top,
+                top + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed
+            );
+
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+            if (!won)
+                return std::nullopt;
+
+            return element;
+        }
+
+        std::optional<T> steal() {
+            auto top = mTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = mBottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return std::nullopt;
+
+            const auto element = mArray.load(std::memory_order_acquire)->get(top);
+
+            if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return std::nullopt;
+
+            return element;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            const auto bottom = mBottom.load(std::memory_order_relaxed);
+            const auto top = mTop.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+    private:
+        Array *grow(const Array *array, const std::int64_t top, const std::int64_t bottom) {
+            auto next = std::make_unique<Array>(array->capacity() * 2);
+
+            for (auto i = top; i < bottom; ++i)
+                next->put(i, array->get(i));
+
+            // thieves may still be reading from the old array, so it is retired together with the deque
+            mArrays.push_back(std::move(next));
+            mArray.store(mArrays.back().get(), std::memory_order_release);
+
+            return mArrays.back().get();
+        }
+
+        alignas(64) std::atomic<std::int64_t> mTop;
+        alignas(64) std::atomic<std::int64_t> mBottom;
+        std::atomic<Array *> mArray;
+        std::vector<std::unique_ptr<Array>> mArrays;
+    };
+}
+
+#endif //ZERO_ATOMIC_WORK_STEALING_DEQUE_H
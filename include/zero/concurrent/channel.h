@@ -1,69 +1,116 @@
 #ifndef ZERO_CONCURRENT_CHANNEL_H
 #define ZERO_CONCURRENT_CHANNEL_H
 
+#include <list>
+#include <mutex>
 #include <chrono>
+#include <limits>
+#include <ranges>
+#include <vector>
+#include <variant>
+#include <utility>
+#include <iterator>
 #include <optional>
-#include <condition_variable>
+#include <algorithm>
+#include <functional>
 #include <zero/error.h>
+#include <zero/defer.h>
+#include <zero/async/promise.h>
+#include <zero/atomic/event.h>
+#include <zero/atomic/cache_line.h>
+#include <zero/atomic/spsc_buffer.h>
 #include <zero/atomic/circular_buffer.h>
+#include <zero/atomic/segmented_buffer.h>
 
 namespace zero::concurrent {
-    template<typename T>
-    struct ChannelCore {
-        struct Context {
-            bool waiting{};
-            std::condition_variable cv;
-            std::atomic<std::size_t> refCount;
-        };
+    // Events of the `select` calls waiting on a channel among others. Every notification of the receiver side sets
+    // them all, so a single sleep covers each channel passed to `select`.
+    class SelectWaiters {
+    public:
+        void add(atomic::Event &event);
+        void remove(atomic::Event &event);
 
-        explicit ChannelCore(const std::size_t capacity) : buffer{capacity + 1} {
+        void notify() {
+            if (mCount.load(std::memory_order_relaxed) == 0)
+                return;
+
+            wake();
         }
 
-        std::mutex mutex;
-        std::atomic<bool> closed;
-        atomic::CircularBuffer<T> buffer;
-        Context sender;
-        Context receiver;
+    private:
+        void wake();
 
-        void notifySender() {
-            {
-                const std::lock_guard guard{mutex};
+        std::mutex mMutex;
+        std::vector<atomic::Event *> mEvents;
+        std::atomic<std::size_t> mCount{0};
+    };
 
-                if (!sender.waiting)
+    // Requests of `sendAsync` and `receiveAsync` that could not be fulfilled right away, in arrival order. They are
+    // fulfilled by whichever thread changes the buffer next, instead of parking a thread of their own.
+    template<typename W>
+    class WaiterQueue {
+    public:
+        // Withdraws `waiter` and rejects it with `std::errc::operation_canceled` once `token` is cancelled, unless it
+        // has been taken off the queue by then. `queue` shares the ownership of the channel it belongs to.
+        static void watch(
+            const std::shared_ptr<WaiterQueue> &queue,
+            const std::shared_ptr<W> &waiter,
+            const async::CancellationToken &token
+        ) {
+            waiter->subscription = token.subscribe([weakQueue = std::weak_ptr{queue}, weakWaiter = std::weak_ptr{waiter}] {
+                const auto self = weakQueue.lock();
+                const auto target = weakWaiter.lock();
+
+                if (!self || !target || !self->remove(target))
                     return;
 
-                sender.waiting = false;
-            }
+                target->promise.reject(std::make_error_code(std::errc::operation_canceled));
+            });
+        }
 
-            sender.cv.notify_all();
+        void push(std::shared_ptr<W> waiter) {
+            std::lock_guard guard{mMutex};
+            mWaiters.push_back(std::move(waiter));
+            mCount.fetch_add(1, std::memory_order_relaxed);
         }
 
-        void notifyReceiver() {
-            {
-                const std::lock_guard guard{mutex};
+        bool remove(const std::shared_ptr<W> &waiter) {
+            std::lock_guard guard{mMutex};
 
-                if (!receiver.waiting)
-                    return;
+            const auto it = std::ranges::find(mWaiters, waiter);
 
-                receiver.waiting = false;
-            }
+            if (it == mWaiters.end())
+                return false;
 
-            receiver.cv.notify_all();
+            mWaiters.erase(it);
+            mCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
         }
 
-        void close() {
-            {
-                const std::lock_guard guard{mutex};
-
-                if (closed)
-                    return;
-
-                closed = true;
+        // Takes waiters off the front for as long as `f` fulfils them, they are returned to be settled outside of the
+        // lock, since a continuation may run inline and use the channel again.
+        template<typename F>
+        std::vector<std::shared_ptr<W>> drain(F &&f) {
+            std::vector<std::shared_ptr<W>> drained;
+            std::lock_guard guard{mMutex};
+
+            while (!mWaiters.empty() && std::invoke(f, *mWaiters.front())) {
+                drained.push_back(std::move(mWaiters.front()));
+                mWaiters.pop_front();
+                mCount.fetch_sub(1, std::memory_order_relaxed);
             }
 
-            notifySender();
-            notifyReceiver();
+            return drained;
+        }
+
+        [[nodiscard]] bool pending() const {
+            return mCount.load(std::memory_order_relaxed) > 0;
         }
+
+    private:
+        std::mutex mMutex;
+        std::list<std::shared_ptr<W>> mWaiters;
+        std::atomic<std::size_t> mCount{0};
     };
 
     Z_DEFINE_ERROR_CODE_EX(
@@ -80,20 +127,380 @@ namespace zero::concurrent {
         Timeout, "Send operation timed out", std::errc::timed_out
     )
 
+    Z_DEFINE_ERROR_CODE_EX(
+        TryReceiveError,
+        "zero::concurrent::Receiver::tryReceive",
+        Disconnected, "Receiving on an empty and disconnected channel", Z_DEFAULT_ERROR_CONDITION,
+        Empty, "Receiving on an empty channel", std::errc::operation_would_block
+    )
+
+    Z_DEFINE_ERROR_CODE_EX(
+        ReceiveError,
+        "zero::concurrent::Receiver::receive",
+        Disconnected, "Receiving on an empty and disconnected channel", Z_DEFAULT_ERROR_CONDITION,
+        Timeout, "Receive operation timed out", std::errc::timed_out
+    )
+
+    // Statistics policy of a channel that records nothing, none of the hooks is even compiled in.
+    struct NoChannelStats {
+        static constexpr bool Enabled = false;
+    };
+
+    // Statistics policy that counts the traffic, contention and waiting of a channel with relaxed atomics. Each side
+    // writes its own cache line, so senders and receivers do not contend on the counters either.
+    class ChannelStats {
+    public:
+        static constexpr bool Enabled = true;
+
+        struct Snapshot {
+            std::size_t highWaterMark;
+            std::size_t sent;
+            std::size_t received;
+            std::size_t senderParks;
+            std::size_t receiverParks;
+            std::chrono::nanoseconds senderParkTime;
+            std::chrono::nanoseconds receiverParkTime;
+            std::size_t sendRetries;
+            std::size_t receiveRetries;
+        };
+
+        void sent(const std::size_t n, const std::size_t size) {
+            mSender.transferred.fetch_add(n, std::memory_order_relaxed);
+
+            auto mark = mHighWaterMark.load(std::memory_order_relaxed);
+
+            while (size > mark && !mHighWaterMark.compare_exchange_weak(mark, size, std::memory_order_relaxed)) {
+            }
+        }
+
+        void received(const std::size_t n) {
+            mReceiver.transferred.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        void senderRetried(const std::size_t n) {
+            mSender.retries.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        void receiverRetried(const std::size_t n) {
+            mReceiver.retries.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        void senderParked(const std::chrono::nanoseconds duration) {
+            mSender.parked(duration);
+        }
+
+        void receiverParked(const std::chrono::nanoseconds duration) {
+            mReceiver.parked(duration);
+        }
+
+        [[nodiscard]] Snapshot snapshot() const;
+
+    private:
+        struct alignas(atomic::CacheLineSize) Side {
+            std::atomic<std::size_t> transferred{0};
+            std::atomic<std::size_t> retries{0};
+            std::atomic<std::size_t> parks{0};
+            std::atomic<std::chrono::nanoseconds::rep> parkTime{0};
+
+            void parked(const std::chrono::nanoseconds duration) {
+                parks.fetch_add(1, std::memory_order_relaxed);
+                parkTime.fetch_add(duration.count(), std::memory_order_relaxed);
+            }
+        };
+
+        Side mSender;
+        Side mReceiver;
+        alignas(atomic::CacheLineSize) std::atomic<std::size_t> mHighWaterMark{0};
+    };
+
+    template<typename T, typename B = atomic::CircularBuffer<T>, typename S = NoChannelStats>
+    struct ChannelCore {
+        struct Context {
+            atomic::EventCount event;
+            std::atomic<std::size_t> refCount;
+        };
+
+        struct SendWaiter {
+            async::promise::Promise<void, std::error_code> promise;
+            // reset once moved into the buffer
+            std::optional<T> element;
+            async::CancellationSubscription subscription;
+        };
+
+        struct ReceiveWaiter {
+            async::promise::Promise<T, std::error_code> promise;
+            std::optional<T> element;
+            async::CancellationSubscription subscription;
+        };
+
+        template<typename... Args>
+        explicit ChannelCore(Args &&... args) : buffer{std::forward<Args>(args)...} {
+        }
+
+        std::atomic<bool> closed;
+        B buffer;
+        Context sender;
+        Context receiver;
+        SelectWaiters selectWaiters;
+        WaiterQueue<SendWaiter> sendWaiters;
+        WaiterQueue<ReceiveWaiter> receiveWaiters;
+        [[no_unique_address]] S stats;
+
+        // The buffer operations the endpoints go through, so that an enabled statistics policy sees every transfer.
+        auto reserve() {
+            if constexpr (S::Enabled && requires(std::size_t retries) { buffer.reserve(retries); }) {
+                std::size_t retries{0};
+                auto index = buffer.reserve(retries);
+
+                if (retries > 0)
+                    stats.senderRetried(retries);
+
+                return index;
+            }
+            else {
+                return buffer.reserve();
+            }
+        }
+
+        template<typename I, typename... Args>
+        void commit(const I index, Args &&... args) {
+            buffer.commit(index, std::forward<Args>(args)...);
+
+            if constexpr (S::Enabled)
+                stats.sent(1, buffer.size());
+        }
+
+        auto acquire() {
+            if constexpr (S::Enabled && requires(std::size_t retries) { buffer.acquire(retries); }) {
+                std::size_t retries{0};
+                auto index = buffer.acquire(retries);
+
+                if (retries > 0)
+                    stats.receiverRetried(retries);
+
+                return index;
+            }
+            else {
+                return buffer.acquire();
+            }
+        }
+
+        template<typename I>
+        void release(const I index) {
+            buffer.release(index);
+
+            if constexpr (S::Enabled)
+                stats.received(1);
+        }
+
+        template<typename F>
+        std::size_t produce(const std::size_t n, F &&f) {
+            const auto count = buffer.produce(n, std::forward<F>(f));
+
+            if constexpr (S::Enabled) {
+                if (count > 0)
+                    stats.sent(count, buffer.size());
+            }
+
+            return count;
+        }
+
+        template<typename F>
+        std::size_t consume(const std::size_t n, F &&f) {
+            const auto count = buffer.consume(n, std::forward<F>(f));
+
+            if constexpr (S::Enabled) {
+                if (count > 0)
+                    stats.received(count);
+            }
+
+            return count;
+        }
+
+        // Sleeps on `context` until `ready` holds or the channel is closed, returns false if the timeout elapsed first.
+        // A wake-up that leaves `ready` false goes back to sleep for the time that is left, rather than for the whole
+        // timeout again. The caller re-checks the buffer either way, since another thread may have got to it first.
+        template<typename F>
+        bool park(Context &context, F &&ready, const std::optional<std::chrono::milliseconds> timeout) {
+            std::optional<std::chrono::steady_clock::time_point> deadline;
+
+            if (timeout)
+                deadline = std::chrono::steady_clock::now() + *timeout;
+
+            while (true) {
+                const auto key = context.event.prepare();
+
+                if (closed || std::invoke(ready)) {
+                    context.event.cancel();
+                    return true;
+                }
+
+                std::optional<std::chrono::milliseconds> remaining;
+
+                if (deadline) {
+                    remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                        *deadline - std::chrono::steady_clock::now()
+                    );
+
+                    if (remaining->count() <= 0) {
+                        context.event.cancel();
+                        return false;
+                    }
+                }
+
+                std::chrono::steady_clock::time_point start;
+
+                if constexpr (S::Enabled)
+                    start = std::chrono::steady_clock::now();
+
+                const auto result = context.event.wait(key, remaining);
+
+                if constexpr (S::Enabled) {
+                    const auto duration = std::chrono::steady_clock::now() - start;
+
+                    if (&context == &sender)
+                        stats.senderParked(duration);
+                    else
+                        stats.receiverParked(duration);
+                }
+
+                if (!result) {
+                    if (result.error() != std::errc::timed_out)
+                        throw error::StacktraceError<std::system_error>{result.error()};
+
+                    return false;
+                }
+            }
+        }
+
+        void notifySender() {
+            sender.event.notify();
+
+            if (sendWaiters.pending())
+                serveSenders();
+        }
+
+        void notifyReceiver() {
+            receiver.event.notify();
+            // the fence `notify()` starts with also orders these loads after the change being published
+            selectWaiters.notify();
+
+            if (receiveWaiters.pending())
+                serveReceivers();
+        }
+
+        // Queued waiters have to be able to give up through `Future::cancel` or `Future::timeout` even if the caller
+        // passed no token of their own.
+        template<typename W>
+        static std::shared_ptr<W>
+        makeWaiter(const async::CancellationToken &token, std::optional<T> element = std::nullopt) {
+            return std::make_shared<W>(
+                decltype(W::promise){token.cancellable() ? token : async::CancellationSource{}.token()},
+                std::move(element)
+            );
+        }
+
+        // Moves the elements of queued senders into the buffer while there is room, or fails them all once closed.
+        void serveSenders() {
+            const auto served = sendWaiters.drain([this](SendWaiter &waiter) {
+                if (closed)
+                    return true;
+
+                const auto index = reserve();
+
+                if (!index)
+                    return false;
+
+                commit(*index, *std::move(waiter.element));
+                waiter.element.reset();
+                return true;
+            });
+
+            if (served.empty())
+                return;
+
+            if (std::ranges::any_of(served, [](const auto &waiter) { return !waiter->element; }))
+                notifyReceiver();
+
+            for (const auto &waiter: served) {
+                if (waiter->element) {
+                    waiter->promise.reject(make_error_code(SendError::Disconnected));
+                    continue;
+                }
+
+                waiter->promise.resolve();
+            }
+        }
+
+        // Hands buffered elements to queued receivers, or fails them all once the channel is closed and drained.
+        void serveReceivers() {
+            const auto served = receiveWaiters.drain([this](ReceiveWaiter &waiter) {
+                if (const auto index = acquire(); index) {
+                    waiter.element.emplace(std::move(buffer[*index]));
+                    release(*index);
+                    return true;
+                }
+
+                return closed && buffer.empty();
+            });
+
+            if (served.empty())
+                return;
+
+            if (std::ranges::any_of(served, [](const auto &waiter) { return waiter->element.has_value(); }))
+                notifySender();
+
+            for (const auto &waiter: served) {
+                if (!waiter->element) {
+                    waiter->promise.reject(make_error_code(ReceiveError::Disconnected));
+                    continue;
+                }
+
+                waiter->promise.resolve(*std::move(waiter->element));
+            }
+        }
+
+        void close() {
+            if (closed.exchange(true))
+                return;
+
+            notifySender();
+            notifyReceiver();
+        }
+    };
+
+    // Endpoints of a channel backed by `atomic::SPSCBuffer` are move-only, so there is only ever one of each.
+    template<typename B>
+    inline constexpr bool SharedEndpoint = true;
+
     template<typename T>
+    inline constexpr bool SharedEndpoint<atomic::SPSCBuffer<T>> = false;
+
+    // The elements of an owning range passed as an rvalue are moved into the channel, a borrowed one is copied from.
+    template<typename R>
+    inline constexpr bool MovesElements = !std::is_lvalue_reference_v<R> && !std::ranges::borrowed_range<R>;
+
+    template<typename R>
+    using SentElement = std::conditional_t<
+        MovesElements<R>,
+        std::ranges::range_rvalue_reference_t<R>,
+        std::ranges::range_reference_t<R>
+    >;
+
+    template<typename T, typename B = atomic::CircularBuffer<T>, typename S = NoChannelStats>
     class Sender {
     public:
-        explicit Sender(std::shared_ptr<ChannelCore<T>> core) : mCore{std::move(core)} {
+        explicit Sender(std::shared_ptr<ChannelCore<T, B, S>> core) : mCore{std::move(core)} {
             ++mCore->sender.refCount;
         }
 
-        Sender(const Sender &rhs) : mCore{rhs.mCore} {
+        Sender(const Sender &rhs) requires SharedEndpoint<B> : mCore{rhs.mCore} {
             ++mCore->sender.refCount;
         }
 
         Sender(Sender &&rhs) = default;
 
-        Sender &operator=(const Sender &rhs) {
+        Sender &operator=(const Sender &rhs) requires SharedEndpoint<B> {
             mCore = rhs.mCore;
             ++mCore->sender.refCount;
             return *this;
@@ -116,13 +523,12 @@ namespace zero::concurrent {
             if (mCore->closed)
                 return std::unexpected{TrySendError::Disconnected};
 
-            const auto index = mCore->buffer.reserve();
+            const auto index = mCore->reserve();
 
             if (!index)
                 return std::unexpected{TrySendError::Full};
 
-            mCore->buffer[*index] = std::forward<U>(element);
-            mCore->buffer.commit(*index);
+            mCore->commit(*index, std::forward<U>(element));
 
             mCore->notifyReceiver();
             return {};
@@ -132,13 +538,12 @@ namespace zero::concurrent {
             if (mCore->closed)
                 return std::unexpected{std::pair{std::move(element), TrySendError::Disconnected}};
 
-            const auto index = mCore->buffer.reserve();
+            const auto index = mCore->reserve();
 
             if (!index)
                 return std::unexpected{std::pair{std::move(element), TrySendError::Full}};
 
-            mCore->buffer[*index] = std::move(element);
-            mCore->buffer.commit(*index);
+            mCore->commit(*index, std::move(element));
 
             mCore->notifyReceiver();
             return {};
@@ -151,31 +556,18 @@ namespace zero::concurrent {
                 return std::unexpected{SendError::Disconnected};
 
             while (true) {
-                const auto index = mCore->buffer.reserve();
+                const auto index = mCore->reserve();
 
                 if (index) {
-                    mCore->buffer[*index] = std::forward<U>(element);
-                    mCore->buffer.commit(*index);
+                    mCore->commit(*index, std::forward<U>(element));
                     mCore->notifyReceiver();
                     return {};
                 }
 
-                std::unique_lock lock{mCore->mutex};
-
                 if (mCore->closed)
                     return std::unexpected{SendError::Disconnected};
 
-                if (!mCore->buffer.full())
-                    continue;
-
-                mCore->sender.waiting = true;
-
-                if (!timeout) {
-                    mCore->sender.cv.wait(lock);
-                    continue;
-                }
-
-                if (mCore->sender.cv.wait_for(lock, *timeout) == std::cv_status::timeout)
+                if (!mCore->park(mCore->sender, [this] { return !mCore->buffer.full(); }, timeout))
                     return std::unexpected{SendError::Timeout};
             }
         }
@@ -186,33 +578,120 @@ namespace zero::concurrent {
                 return std::unexpected{std::pair{std::move(element), SendError::Disconnected}};
 
             while (true) {
-                const auto index = mCore->buffer.reserve();
+                const auto index = mCore->reserve();
 
                 if (index) {
-                    mCore->buffer[*index] = std::move(element);
-                    mCore->buffer.commit(*index);
+                    mCore->commit(*index, std::move(element));
                     mCore->notifyReceiver();
                     return {};
                 }
 
-                std::unique_lock lock{mCore->mutex};
-
                 if (mCore->closed)
                     return std::unexpected{std::pair{std::move(element), SendError::Disconnected}};
 
-                if (!mCore->buffer.full())
-                    continue;
+                if (!mCore->park(mCore->sender, [this] { return !mCore->buffer.full(); }, timeout))
+                    return std::unexpected{std::pair{std::move(element), SendError::Timeout}};
+            }
+        }
+
+        // Sends without blocking the calling thread: if the channel is full, the element is queued in the channel and
+        // moved into the buffer by the receiver that frees a slot, whose thread runs the continuation unless the future
+        // is moved to another executor with `via`. Cancelling the future, through `token` or by `Future::timeout`,
+        // withdraws the element and rejects it with `std::errc::operation_canceled`. Not offered on SPSC channels,
+        // where the other side would end up touching the buffer from the wrong thread.
+        template<typename U = T>
+        async::promise::Future<void, std::error_code>
+        sendAsync(U &&element, const async::CancellationToken &token = {}) requires SharedEndpoint<B> {
+            using Core = ChannelCore<T, B, S>;
+
+            if (mCore->closed)
+                return async::promise::Future<void, std::error_code>::rejected(
+                    make_error_code(SendError::Disconnected)
+                );
+
+            if (const auto index = mCore->reserve(); index) {
+                mCore->commit(*index, std::forward<U>(element));
+                mCore->notifyReceiver();
+                return async::promise::Future<void, std::error_code>::resolved();
+            }
+
+            const auto waiter = Core::template makeWaiter<typename Core::SendWaiter>(
+                token,
+                T(std::forward<U>(element))
+            );
 
-                mCore->sender.waiting = true;
+            const auto cancellation = waiter->promise.token();
+            auto future = waiter->promise.getFuture().via();
 
-                if (!timeout) {
-                    mCore->sender.cv.wait(lock);
+            mCore->sendWaiters.push(waiter);
+
+            // queuing has to be ordered before the re-check, against the fence on the notifying side
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            mCore->serveSenders();
+
+            WaiterQueue<typename Core::SendWaiter>::watch({mCore, &mCore->sendWaiters}, waiter, cancellation);
+            return future;
+        }
+
+        // Sends as many elements from the front of `range` as currently fit, returns how many were sent.
+        template<std::ranges::input_range R>
+            requires (std::ranges::sized_range<R> && std::constructible_from<T, SentElement<R>>)
+        std::expected<std::size_t, TrySendError> trySendMany(R &&range) {
+            if (mCore->closed)
+                return std::unexpected{TrySendError::Disconnected};
+
+            const auto size = static_cast<std::size_t>(std::ranges::size(range));
+
+            if (size == 0)
+                return 0;
+
+            auto it = std::ranges::begin(range);
+            const auto n = push<MovesElements<R>>(it, size);
+
+            if (n == 0)
+                return std::unexpected{TrySendError::Full};
+
+            mCore->notifyReceiver();
+            return n;
+        }
+
+        // Sends every element of `range`, blocking while the channel is full. Like `IWriter::write`, an error is only
+        // returned if nothing was sent, otherwise the number of elements sent before the failure is returned.
+        template<std::ranges::input_range R>
+            requires (std::ranges::sized_range<R> && std::constructible_from<T, SentElement<R>>)
+        std::expected<std::size_t, SendError>
+        sendMany(R &&range, const std::optional<std::chrono::milliseconds> timeout = std::nullopt) {
+            if (mCore->closed)
+                return std::unexpected{SendError::Disconnected};
+
+            auto it = std::ranges::begin(range);
+            auto remaining = static_cast<std::size_t>(std::ranges::size(range));
+            std::size_t sent{0};
+
+            while (remaining > 0) {
+                if (const auto n = push<MovesElements<R>>(it, remaining); n > 0) {
+                    sent += n;
+                    remaining -= n;
+                    mCore->notifyReceiver();
                     continue;
                 }
 
-                if (mCore->sender.cv.wait_for(lock, *timeout) == std::cv_status::timeout)
-                    return std::unexpected{std::pair{std::move(element), SendError::Timeout}};
+                if (mCore->closed) {
+                    if (sent > 0)
+                        return sent;
+
+                    return std::unexpected{SendError::Disconnected};
+                }
+
+                if (!mCore->park(mCore->sender, [this] { return !mCore->buffer.full(); }, timeout)) {
+                    if (sent > 0)
+                        return sent;
+
+                    return std::unexpected{SendError::Timeout};
+                }
             }
+
+            return sent;
         }
 
         void close() {
@@ -239,38 +718,40 @@ namespace zero::concurrent {
             return mCore->closed;
         }
 
-    private:
-        std::shared_ptr<ChannelCore<T>> mCore;
-    };
+        [[nodiscard]] ChannelStats::Snapshot stats() const requires S::Enabled {
+            return mCore->stats.snapshot();
+        }
 
-    Z_DEFINE_ERROR_CODE_EX(
-        TryReceiveError,
-        "zero::concurrent::Receiver::tryReceive",
-        Disconnected, "Receiving on an empty and disconnected channel", Z_DEFAULT_ERROR_CONDITION,
-        Empty, "Receiving on an empty channel", std::errc::operation_would_block
-    )
+    private:
+        template<bool Move, typename I>
+        std::size_t push(I &it, const std::size_t n) {
+            return mCore->produce(n, [&] {
+                Z_DEFER(++it);
+
+                if constexpr (Move)
+                    return T(std::ranges::iter_move(it));
+                else
+                    return T(*it);
+            });
+        }
 
-    Z_DEFINE_ERROR_CODE_EX(
-        ReceiveError,
-        "zero::concurrent::Receiver::receive",
-        Disconnected, "Receiving on an empty and disconnected channel", Z_DEFAULT_ERROR_CONDITION,
-        Timeout, "Receive operation timed out", std::errc::timed_out
-    )
+        std::shared_ptr<ChannelCore<T, B, S>> mCore;
+    };
 
-    template<typename T>
+    template<typename T, typename B = atomic::CircularBuffer<T>, typename S = NoChannelStats>
     class Receiver {
     public:
-        explicit Receiver(std::shared_ptr<ChannelCore<T>> core) : mCore{std::move(core)} {
+        explicit Receiver(std::shared_ptr<ChannelCore<T, B, S>> core) : mCore{std::move(core)} {
             ++mCore->receiver.refCount;
         }
 
-        Receiver(const Receiver &rhs) : mCore{rhs.mCore} {
+        Receiver(const Receiver &rhs) requires SharedEndpoint<B> : mCore{rhs.mCore} {
             ++mCore->receiver.refCount;
         }
 
         Receiver(Receiver &&rhs) = default;
 
-        Receiver &operator=(const Receiver &rhs) {
+        Receiver &operator=(const Receiver &rhs) requires SharedEndpoint<B> {
             mCore = rhs.mCore;
             ++mCore->receiver.refCount;
             return *this;
@@ -289,13 +770,13 @@ namespace zero::concurrent {
         }
 
         std::expected<T, TryReceiveError> tryReceive() {
-            const auto index = mCore->buffer.acquire();
+            const auto index = mCore->acquire();
 
             if (!index)
                 return std::unexpected{mCore->closed ? TryReceiveError::Disconnected : TryReceiveError::Empty};
 
             auto element = std::move(mCore->buffer[*index]);
-            mCore->buffer.release(*index);
+            mCore->release(*index);
 
             mCore->notifySender();
             return element;
@@ -303,31 +784,90 @@ namespace zero::concurrent {
 
         std::expected<T, ReceiveError> receive(const std::optional<std::chrono::milliseconds> timeout = std::nullopt) {
             while (true) {
-                const auto index = mCore->buffer.acquire();
+                const auto index = mCore->acquire();
 
                 if (index) {
                     auto element = std::move(mCore->buffer[*index]);
-                    mCore->buffer.release(*index);
+                    mCore->release(*index);
                     mCore->notifySender();
                     return element;
                 }
 
-                std::unique_lock lock{mCore->mutex};
+                if (mCore->closed && mCore->buffer.empty())
+                    return std::unexpected{ReceiveError::Disconnected};
 
-                if (!mCore->buffer.empty())
-                    continue;
+                if (!mCore->park(mCore->receiver, [this] { return !mCore->buffer.empty(); }, timeout))
+                    return std::unexpected{ReceiveError::Timeout};
+            }
+        }
 
-                if (mCore->closed)
-                    return std::unexpected{ReceiveError::Disconnected};
+        // Receives without blocking the calling thread: if the channel is empty, the request is queued in the channel
+        // and fulfilled by the sender that fills it, whose thread runs the continuation unless the future is moved to
+        // another executor with `via`. Cancelling the future, through `token` or by `Future::timeout`, withdraws the
+        // request and rejects it with `std::errc::operation_canceled`. Not offered on SPSC channels, where the other
+        // side would end up touching the buffer from the wrong thread.
+        async::promise::Future<T, std::error_code> receiveAsync(const async::CancellationToken &token = {})
+            requires SharedEndpoint<B> {
+            using Core = ChannelCore<T, B, S>;
+
+            if (const auto index = mCore->acquire(); index) {
+                auto element = std::move(mCore->buffer[*index]);
+                mCore->release(*index);
+                mCore->notifySender();
+                return async::promise::Future<T, std::error_code>::resolved(std::move(element));
+            }
 
-                mCore->receiver.waiting = true;
+            if (mCore->closed && mCore->buffer.empty())
+                return async::promise::Future<T, std::error_code>::rejected(
+                    make_error_code(ReceiveError::Disconnected)
+                );
 
-                if (!timeout) {
-                    mCore->receiver.cv.wait(lock);
-                    continue;
+            const auto waiter = Core::template makeWaiter<typename Core::ReceiveWaiter>(token);
+            const auto cancellation = waiter->promise.token();
+            auto future = waiter->promise.getFuture().via();
+
+            mCore->receiveWaiters.push(waiter);
+
+            // queuing has to be ordered before the re-check, against the fence on the notifying side
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            mCore->serveReceivers();
+
+            WaiterQueue<typename Core::ReceiveWaiter>::watch({mCore, &mCore->receiveWaiters}, waiter, cancellation);
+            return future;
+        }
+
+        // Moves up to `max` elements into `out`, returns how many were received.
+        template<std::output_iterator<T> O>
+        std::expected<std::size_t, TryReceiveError> tryReceiveMany(O out, const std::size_t max) {
+            if (max == 0)
+                return 0;
+
+            const auto n = pull(out, max);
+
+            if (n == 0)
+                return std::unexpected{mCore->closed ? TryReceiveError::Disconnected : TryReceiveError::Empty};
+
+            mCore->notifySender();
+            return n;
+        }
+
+        // Waits until at least one element is available, then moves up to `max` of them into `out`.
+        template<std::output_iterator<T> O>
+        std::expected<std::size_t, ReceiveError>
+        receiveMany(O out, const std::size_t max, const std::optional<std::chrono::milliseconds> timeout = std::nullopt) {
+            if (max == 0)
+                return 0;
+
+            while (true) {
+                if (const auto n = pull(out, max); n > 0) {
+                    mCore->notifySender();
+                    return n;
                 }
 
-                if (mCore->receiver.cv.wait_for(lock, *timeout) == std::cv_status::timeout)
+                if (mCore->closed && mCore->buffer.empty())
+                    return std::unexpected{ReceiveError::Disconnected};
+
+                if (!mCore->park(mCore->receiver, [this] { return !mCore->buffer.empty(); }, timeout))
                     return std::unexpected{ReceiveError::Timeout};
             }
         }
@@ -352,10 +892,115 @@ namespace zero::concurrent {
             return mCore->closed;
         }
 
+        [[nodiscard]] ChannelStats::Snapshot stats() const requires S::Enabled {
+            return mCore->stats.snapshot();
+        }
+
     private:
-        std::shared_ptr<ChannelCore<T>> mCore;
+        template<typename O>
+        std::size_t pull(O &out, const std::size_t n) {
+            return mCore->consume(n, [&](T &slot) {
+                *out = std::move(slot);
+                ++out;
+            });
+        }
+
+        std::shared_ptr<ChannelCore<T, B, S>> mCore;
+
+        friend struct SelectAccess;
+    };
+
+    struct SelectAccess {
+        template<typename T, typename B, typename S>
+        static SelectWaiters &waiters(const Receiver<T, B, S> &receiver) {
+            return receiver.mCore->selectWaiters;
+        }
     };
 
+    // Takes an element from the first of `receivers` that has one, starting at a different receiver on each call so
+    // that a busy channel cannot starve the others. The index of the variant tells which receiver it came from.
+    template<typename... Ts, typename... Bs, typename... Ss>
+    std::expected<std::variant<Ts...>, TryReceiveError> trySelect(Receiver<Ts, Bs, Ss> &... receivers) {
+        static_assert(sizeof...(receivers) > 0);
+
+        thread_local std::size_t counter{0};
+        const auto start = counter++ % sizeof...(receivers);
+
+        std::optional<std::variant<Ts...>> element;
+        bool disconnected{true};
+
+        const auto poll = [&]<std::size_t I>(std::integral_constant<std::size_t, I>, auto &receiver) {
+            auto result = receiver.tryReceive();
+
+            if (!result) {
+                if (result.error() == TryReceiveError::Empty)
+                    disconnected = false;
+
+                return false;
+            }
+
+            element.emplace(std::in_place_index<I>, std::move(*result));
+            return true;
+        };
+
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ((Is >= start && poll(std::integral_constant<std::size_t, Is>{}, receivers)) || ...) ||
+                ((Is < start && poll(std::integral_constant<std::size_t, Is>{}, receivers)) || ...);
+        }(std::index_sequence_for<Ts...>{});
+
+        if (!element)
+            return std::unexpected{disconnected ? TryReceiveError::Disconnected : TryReceiveError::Empty};
+
+        return *std::move(element);
+    }
+
+    // Waits until any of `receivers` has an element and takes it. Fails with `Disconnected` only once every channel is
+    // closed and drained, a closed channel is skipped while others remain.
+    template<typename... Ts, typename... Bs, typename... Ss>
+    std::expected<std::variant<Ts...>, ReceiveError>
+    select(const std::optional<std::chrono::milliseconds> timeout, Receiver<Ts, Bs, Ss> &... receivers) {
+        if (auto result = trySelect(receivers...); result)
+            return *std::move(result);
+        else if (result.error() == TryReceiveError::Disconnected)
+            return std::unexpected{ReceiveError::Disconnected};
+
+        const auto deadline = timeout.transform([](const auto &duration) {
+            return std::chrono::steady_clock::now() + duration;
+        });
+
+        atomic::Event event;
+
+        (SelectAccess::waiters(receivers).add(event), ...);
+        Z_DEFER((SelectAccess::waiters(receivers).remove(event), ...));
+
+        // registering has to be ordered before the re-check, against the fence on the notifying side
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        while (true) {
+            if (auto result = trySelect(receivers...); result)
+                return *std::move(result);
+            else if (result.error() == TryReceiveError::Disconnected)
+                return std::unexpected{ReceiveError::Disconnected};
+
+            std::optional<std::chrono::milliseconds> remaining;
+
+            if (deadline) {
+                remaining = std::chrono::ceil<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now());
+
+                if (*remaining <= std::chrono::milliseconds::zero())
+                    return std::unexpected{ReceiveError::Timeout};
+            }
+
+            if (const auto result = event.wait(remaining); !result && result.error() != std::errc::timed_out)
+                throw error::StacktraceError<std::system_error>{result.error()};
+        }
+    }
+
+    template<typename... Ts, typename... Bs, typename... Ss>
+    std::expected<std::variant<Ts...>, ReceiveError> select(Receiver<Ts, Bs, Ss> &... receivers) {
+        return select(std::nullopt, receivers...);
+    }
+
     Z_DEFINE_ERROR_CONDITION_EX(
         ChannelError,
         "zero::concurrent::channel",
@@ -369,13 +1014,54 @@ namespace zero::concurrent {
         }
     )
 
-    template<typename T>
-    using Channel = std::pair<Sender<T>, Receiver<T>>;
+    template<typename T, typename S = NoChannelStats>
+    using Channel = std::pair<Sender<T, atomic::CircularBuffer<T>, S>, Receiver<T, atomic::CircularBuffer<T>, S>>;
 
-    template<typename T>
-    Channel<T> channel(const std::size_t capacity = 1) {
-        const auto core = std::make_shared<ChannelCore<T>>(capacity);
-        return {Sender<T>{core}, Receiver<T>{core}};
+    // Pass `ChannelStats` as `S` to have the endpoints report counters through `stats()`.
+    template<typename T, typename S = NoChannelStats>
+    Channel<T, S> channel(const std::size_t capacity = 1) {
+        const auto core = std::make_shared<ChannelCore<T, atomic::CircularBuffer<T>, S>>(capacity + 1);
+        return {Sender<T, atomic::CircularBuffer<T>, S>{core}, Receiver<T, atomic::CircularBuffer<T>, S>{core}};
+    }
+
+    template<typename T, typename S = NoChannelStats>
+    using SPSCSender = Sender<T, atomic::SPSCBuffer<T>, S>;
+
+    template<typename T, typename S = NoChannelStats>
+    using SPSCReceiver = Receiver<T, atomic::SPSCBuffer<T>, S>;
+
+    template<typename T, typename S = NoChannelStats>
+    using SPSCChannel = std::pair<SPSCSender<T, S>, SPSCReceiver<T, S>>;
+
+    // A channel for exactly one producer and one consumer thread, its endpoints are move-only. Sending and receiving
+    // cost a plain load and store on the fast path instead of a CAS loop and per-slot state.
+    template<typename T, typename S = NoChannelStats>
+    SPSCChannel<T, S> spscChannel(const std::size_t capacity = 1) {
+        const auto core = std::make_shared<ChannelCore<T, atomic::SPSCBuffer<T>, S>>(capacity + 1);
+        return {SPSCSender<T, S>{core}, SPSCReceiver<T, S>{core}};
+    }
+
+    template<typename T, typename S = NoChannelStats>
+    using UnboundedSender = Sender<T, atomic::SegmentedBuffer<T>, S>;
+
+    template<typename T, typename S = NoChannelStats>
+    using UnboundedReceiver = Receiver<T, atomic::SegmentedBuffer<T>, S>;
+
+    template<typename T, typename S = NoChannelStats>
+    using UnboundedChannel = std::pair<UnboundedSender<T, S>, UnboundedReceiver<T, S>>;
+
+    // A channel that never reports `Full`, it grows by fixed-size segments during a burst and gives them back once it
+    // has been drained. `onSoftLimit` is invoked with the current size whenever it grows past `softLimit` elements.
+    template<typename T, typename S = NoChannelStats>
+    UnboundedChannel<T, S> unboundedChannel(
+        const std::size_t softLimit = std::numeric_limits<std::size_t>::max(),
+        std::function<void(std::size_t)> onSoftLimit = nullptr
+    ) {
+        const auto core = std::make_shared<ChannelCore<T, atomic::SegmentedBuffer<T>, S>>(
+            softLimit,
+            std::move(onSoftLimit)
+        );
+        return {UnboundedSender<T, S>{core}, UnboundedReceiver<T, S>{core}};
     }
 }
 
@@ -0,0 +1,147 @@
+#ifndef ZERO_FUNCTION_H
+#define ZERO_FUNCTION_H
+
+#include <new>
+#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <zero/meta/type_traits.h>
+
+namespace zero {
+    constexpr std::size_t DefaultSmallFunctionCapacity = 6 * sizeof(void *);
+
+    template<typename Signature, std::size_t Capacity = DefaultSmallFunctionCapacity>
+    class SmallFunction;
+
+    // Move-only callable wrapper, callables that fit into `Capacity` bytes are stored inline without allocation.
+    template<typename R, typename... Args, std::size_t Capacity>
+    class SmallFunction<R(Args...), Capacity> {
+        static_assert(Capacity >= sizeof(void *));
+
+        struct VTable {
+            R (*invoke)(void *, Args &&...);
+            void (*relocate)(void *, void *) noexcept;
+            void (*destroy)(void *) noexcept;
+        };
+
+        template<typename F>
+        static constexpr bool Inline =
+            sizeof(F) <= Capacity &&
+            alignof(F) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        static constexpr VTable InlineVTable{
+            [](void *storage, Args &&... args) -> R {
+                return std::invoke_r<R>(*static_cast<F *>(storage), std::forward<Args>(args)...);
+            },
+            [](void *dst, void *src) noexcept {
+                const auto f = static_cast<F *>(src);
+                std::construct_at(static_cast<F *>(dst), std::move(*f));
+                std::destroy_at(f);
+            },
+            [](void *storage) noexcept {
+                std::destroy_at(static_cast<F *>(storage));
+            }
+        };
+
+        template<typename F>
+        static constexpr VTable HeapVTable{
+            [](void *storage, Args &&... args) -> R {
+                return std::invoke_r<R>(**static_cast<F **>(storage), std::forward<Args>(args)...);
+            },
+            [](void *dst, void *src) noexcept {
+                *static_cast<F **>(dst) = *static_cast<F **>(src);
+            },
+            [](void *storage) noexcept {
+                delete *static_cast<F **>(storage);
+            }
+        };
+
+    public:
+        SmallFunction() = default;
+
+        // ReSharper disable once CppNonExplicitConvertingConstructor
+        SmallFunction(std::nullptr_t) {
+        }
+
+        template<typename F>
+            requires (
+                !std::is_same_v<std::remove_cvref_t<F>, SmallFunction> &&
+                std::is_constructible_v<std::decay_t<F>, F> &&
+                std::is_invocable_r_v<R, std::decay_t<F> &, Args...>
+            )
+        // ReSharper disable once CppNonExplicitConvertingConstructor
+        SmallFunction(F &&f) {
+            using Callable = std::decay_t<F>;
+
+            if constexpr (std::is_pointer_v<Callable> || std::is_member_pointer_v<Callable> ||
+                meta::IsSpecialization<Callable, std::function>) {
+                if (!f)
+                    return;
+            }
+
+            if constexpr (Inline<Callable>) {
+                std::construct_at(reinterpret_cast<Callable *>(mStorage), std::forward<F>(f));
+                mVTable = &InlineVTable<Callable>;
+            }
+            else {
+                *reinterpret_cast<Callable **>(mStorage) = new Callable(std::forward<F>(f));
+                mVTable = &HeapVTable<Callable>;
+            }
+        }
+
+        SmallFunction(SmallFunction &&rhs) noexcept : mVTable{std::exchange(rhs.mVTable, nullptr)} {
+            if (mVTable)
+                mVTable->relocate(mStorage, rhs.mStorage);
+        }
+
+        SmallFunction &operator=(SmallFunction &&rhs) noexcept {
+            if (this == &rhs)
+                return *this;
+
+            reset();
+
+            mVTable = std::exchange(rhs.mVTable, nullptr);
+
+            if (mVTable)
+                mVTable->relocate(mStorage, rhs.mStorage);
+
+            return *this;
+        }
+
+        SmallFunction &operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        ~SmallFunction() {
+            reset();
+        }
+
+        explicit operator bool() const {
+            return mVTable != nullptr;
+        }
+
+        R operator()(Args... args) {
+            assert(mVTable);
+            return mVTable->invoke(mStorage, std::forward<Args>(args)...);
+        }
+
+    private:
+        void reset() {
+            if (!mVTable)
+                return;
+
+            std::exchange(mVTable, nullptr)->destroy(mStorage);
+        }
+
+        const VTable *mVTable{};
+        alignas(std::max_align_t) std::byte mStorage[Capacity];
+    };
+}
+
+#endif //ZERO_FUNCTION_H
@@ -3,7 +3,14 @@
 
 #include "utility.h"
 #include "os/process.h"
-#include "concurrent/channel.h"
+#include "meta/type_traits.h"
+#include "atomic/event.h"
+#include "atomic/evicting_buffer.h"
+#include <bit>
+#include <array>
+#include <cstring>
+#include <map>
+#include <span>
 #include <thread>
 #include <fstream>
 #include <mutex>
@@ -21,6 +28,21 @@ namespace zero::log {
         Debug
     };
 
+    // What `Logger::log` does with a record when the staging ring of the calling thread is full.
+    enum class OverflowPolicy {
+        // wait for room, for at most `ZERO_LOG_TIMEOUT` milliseconds if it is set
+        Block,
+        DropNewest,
+        DropOldest
+    };
+
+    struct DropCounts {
+        // dropped by the overflow policy, including sends that timed out
+        std::size_t overflowed;
+        // dropped by sampling or a rate limit
+        std::size_t sampled;
+    };
+
     struct Record {
         Level level{};
         int line{};
@@ -30,16 +52,113 @@ namespace zero::log {
         std::optional<std::string_view> tag;
     };
 
+    // Arguments whose formatting depends on nothing but their value, so that a byte-wise copy can be formatted later.
+    template<typename T>
+    concept Deferrable = std::is_arithmetic_v<T> ||
+        std::is_enum_v<T> ||
+        meta::IsSpecialization<T, std::chrono::duration> ||
+        meta::IsSpecialization<T, std::chrono::time_point>;
+
+    // A format string checked against `Args` at compile time, like `fmt::format_string`, and which can only be built from
+    // a constant with static storage, so that referencing it until the logger thread gets to it is safe.
+    template<typename... Args>
+    class StaticFormat {
+    public:
+        template<typename S>
+            requires std::convertible_to<const S &, std::string_view>
+        consteval StaticFormat(const S &format) : mFormat{std::string_view{format}} {
+            [[maybe_unused]] const fmt::format_string<Args...> checked{format};
+        }
+
+        [[nodiscard]] constexpr std::string_view get() const {
+            return mFormat;
+        }
+
+    private:
+        std::string_view mFormat;
+    };
+
+    // A message whose formatting is left to the logger thread. The arguments are packed into an inline buffer next to
+    // the format string, which is only referenced.
+    class DeferredMessage {
+    public:
+        static constexpr std::size_t Capacity = 64;
+
+        template<typename... Args>
+        static constexpr bool Fits = (Deferrable<std::remove_cvref_t<Args>> && ...) &&
+            (sizeof(std::remove_cvref_t<Args>) + ... + 0) <= Capacity;
+
+        template<typename... Args>
+            requires Fits<Args...>
+        explicit DeferredMessage(const StaticFormat<std::type_identity_t<Args>...> format, Args &&... args)
+            : mFormat{format.get()}, mRender{&render<std::remove_cvref_t<Args>...>} {
+            [[maybe_unused]] std::size_t offset{0};
+            ((std::memcpy(mArguments.data() + offset, std::addressof(args), sizeof(args)), offset += sizeof(args)), ...);
+        }
+
+        [[nodiscard]] std::string format() const {
+            return mRender(mFormat, mArguments.data());
+        }
+
+    private:
+        template<typename T>
+        static T load(const std::byte *data) {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), data, sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+        template<typename... Args>
+        static std::string render(const fmt::string_view format, const std::byte *data) {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                [[maybe_unused]] constexpr auto offsets = [] {
+                    constexpr std::array<std::size_t, sizeof...(Args)> sizes{sizeof(Args)...};
+                    std::array<std::size_t, sizeof...(Args)> result{};
+
+                    for (std::size_t i{1}; i < sizes.size(); ++i)
+                        result[i] = result[i - 1] + sizes[i - 1];
+
+                    return result;
+                }();
+
+                return fmt::format(fmt::runtime(format), load<Args>(data + offsets[Is])...);
+            }(std::index_sequence_for<Args...>{});
+        }
+
+        fmt::string_view mFormat;
+        std::string (*mRender)(fmt::string_view, const std::byte *);
+        std::array<std::byte, Capacity> mArguments;
+    };
+
+    // Defers the formatting when every argument allows it, and formats right away otherwise.
+    template<typename... Args>
+    auto makeMessage(const StaticFormat<std::type_identity_t<Args>...> format, Args &&... args) {
+        if constexpr (DeferredMessage::Fits<Args...>)
+            return DeferredMessage{format, std::forward<Args>(args)...};
+        else
+            return fmt::format(fmt::runtime(format.get()), std::forward<Args>(args)...);
+    }
+
+    // Any other format string, such as `fmt::runtime(...)`, may not outlive the call, so it is formatted right away.
+    template<typename S, typename... Args>
+        requires (!std::convertible_to<const S &, std::string_view>)
+    std::string makeMessage(S &&format, Args &&... args) {
+        return fmt::format(std::forward<S>(format), std::forward<Args>(args)...);
+    }
+
     class ISink {
     public:
         virtual ~ISink() = default;
         virtual void write(const Record &record) = 0;
+        // The records the logger thread has taken in one wake-up, in order. Writes them one by one unless overridden.
+        virtual void writeBatch(std::span<const Record> records);
         virtual void flush() = 0;
     };
 
     class ConsoleSink final : public ISink {
     public:
         void write(const Record &record) override;
+        void writeBatch(std::span<const Record> records) override;
         void flush() override;
     };
 
@@ -55,12 +174,15 @@ namespace zero::log {
     private:
         void init();
         void rotate();
+        void output(std::string_view data);
 
     protected:
         virtual std::string encode(const Record &record) const;
 
     public:
         void write(const Record &record) override;
+        // Goes through `write()` record by record in a subclass, which may have customized it or `encode()`.
+        void writeBatch(std::span<const Record> records) override;
         void flush() override;
 
     private:
@@ -76,6 +198,50 @@ namespace zero::log {
     class Logger {
         static constexpr auto DefaultFlushInterval = std::chrono::seconds{1};
 
+        struct Entry {
+            Record record;
+            std::optional<DeferredMessage> message;
+        };
+
+        // The ring a thread stages its records in. Only the thread pushes and only the logger thread consumes, the
+        // thread evicts the oldest record itself when asked to drop it, and waits on `space` when asked to block.
+        struct Staging {
+            explicit Staging(std::size_t capacity);
+
+            atomic::EvictingBuffer<Entry> ring;
+            atomic::EventCount space;
+            // set with release by whichever of the thread and the logger goes away first
+            std::atomic<bool> closed;
+        };
+
+        // Keeps one in `every` records, and of those lets at most `limit` through per second of their timestamps.
+        struct RateLimit {
+            std::atomic<std::size_t> every{1};
+            std::atomic<std::size_t> seen{0};
+            std::atomic<std::size_t> limit{std::numeric_limits<std::size_t>::max()};
+            std::atomic<std::int64_t> window{0};
+            std::atomic<std::size_t> count{0};
+
+            bool allow(std::chrono::system_clock::time_point timestamp);
+        };
+
+        // An open-addressing table from tags to `V`, probed linearly and kept at most half full. Never changed once
+        // published, a new one replaces it.
+        template<typename V>
+        struct TagTable {
+            explicit TagTable(const std::map<std::string_view, V> &entries);
+
+            std::vector<std::optional<std::pair<std::string, V>>> slots;
+            std::size_t size;
+
+            [[nodiscard]] const V *find(std::string_view tag) const;
+        };
+
+        // The highest level any sink takes for each tag, replaced whenever the level of some tag changes.
+        using TagLevels = TagTable<Level>;
+        // Replaced when a tag is added, the limits of tags already in it change in place and carry over to the next one.
+        using TagLimits = TagTable<std::shared_ptr<RateLimit>>;
+
         struct Config {
             Level level{};
             std::unique_ptr<ISink> sink;
@@ -90,8 +256,15 @@ namespace zero::log {
         ~Logger();
 
     private:
+        Staging &staging();
+        bool sample(const Record &record);
+        bool stage(Staging &staging, Entry entry);
+        void drain(std::vector<Entry> &batch);
+        std::optional<std::chrono::milliseconds> flushExpired();
         void consume();
-        void refreshMaxLogLevel();
+        void dispatch(std::span<Entry> batch, std::vector<Record> &records);
+        void refreshLevels();
+        void setTagLimit(std::string_view tag, std::atomic<std::size_t> RateLimit::*field, std::size_t value);
 
     public:
         [[nodiscard]] bool enabled(Level level) const;
@@ -110,6 +283,16 @@ namespace zero::log {
         void setLevel(std::string_view name, Level level);
         void setFlushInterval(std::string_view name, std::chrono::milliseconds interval);
 
+        void setOverflowPolicy(OverflowPolicy policy);
+        // `std::nullopt` lifts the limit.
+        void setRateLimit(Level level, std::optional<std::size_t> perSecond);
+        void setRateLimit(std::string_view tag, std::optional<std::size_t> perSecond);
+        // Keeps the first of every `n` records, `std::nullopt` keeps them all again.
+        void setSampleRate(Level level, std::optional<std::size_t> n);
+        void setSampleRate(std::string_view tag, std::optional<std::size_t> n);
+
+        [[nodiscard]] DropCounts dropped() const;
+
         void log(
             Level level,
             std::string_view filename,
@@ -118,18 +301,43 @@ namespace zero::log {
             const std::optional<std::string_view> &tag = std::nullopt
         );
 
+        void log(
+            Level level,
+            std::string_view filename,
+            int line,
+            DeferredMessage message,
+            const std::optional<std::string_view> &tag = std::nullopt
+        );
+
         void sync() const;
 
     private:
+        void enqueue(Entry entry);
+
         mutable std::mutex mMutex;
         std::thread mThread;
         std::once_flag mInitFlag;
         std::list<Config> mConfigs;
         std::optional<Level> mMinLogLevel;
         std::atomic<int> mMaxLogLevel;
+        std::atomic<const TagLevels *> mTagLevels;
+        // the current snapshot last, preceded by the superseded ones a reader still had a hazard on at the last refresh
+        std::list<std::unique_ptr<const TagLevels>> mTagLevelSnapshots;
         std::optional<std::chrono::milliseconds> mSendTimeout;
         std::atomic<std::size_t> mPending;
-        concurrent::Channel<Record> mChannel;
+        std::uint64_t mID;
+        std::atomic<bool> mClosed;
+        atomic::EventCount mEvent;
+        std::mutex mStagingMutex;
+        std::vector<std::shared_ptr<Staging>> mStaging;
+        std::atomic<OverflowPolicy> mOverflowPolicy;
+        std::array<RateLimit, LevelNames.size()> mLevelLimits;
+        // only taken by `setRateLimit`, and by threads reading after their hazard slot is gone
+        std::mutex mTagLimitMutex;
+        std::atomic<const TagLimits *> mTagLimits;
+        std::list<std::unique_ptr<const TagLimits>> mTagLimitSnapshots;
+        std::atomic<std::size_t> mOverflowed;
+        std::atomic<std::size_t> mSampled;
     };
 
     Logger &globalLogger();
@@ -170,14 +378,14 @@ struct fmt::formatter<zero::log::Record, Char> {
 #define Z_INIT_CONSOLE_LOG(level)             Z_GLOBAL_LOGGER.add(level, std::make_unique<zero::log::ConsoleSink>())
 #define Z_INIT_FILE_LOG(level, name, ...)     Z_GLOBAL_LOGGER.add(level, std::make_unique<zero::log::FileSink>(name, ## __VA_ARGS__))
 
-#define Z_LOG_DEBUG(message, ...)             if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Debug)) logger.log(zero::log::Level::Debug, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__))
-#define Z_LOG_INFO(message, ...)              if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Info)) logger.log(zero::log::Level::Info, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__))
-#define Z_LOG_WARNING(message, ...)           if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Warning)) logger.log(zero::log::Level::Warning, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__))
-#define Z_LOG_ERROR(message, ...)             if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Error)) logger.log(zero::log::Level::Error, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__))
+#define Z_LOG_DEBUG(message, ...)             if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Debug)) logger.log(zero::log::Level::Debug, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__))
+#define Z_LOG_INFO(message, ...)              if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Info)) logger.log(zero::log::Level::Info, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__))
+#define Z_LOG_WARNING(message, ...)           if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Warning)) logger.log(zero::log::Level::Warning, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__))
+#define Z_LOG_ERROR(message, ...)             if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Error)) logger.log(zero::log::Level::Error, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__))
 
-#define Z_LOG_DEBUG_T(tag, message, ...)      if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Debug, tag)) logger.log(zero::log::Level::Debug, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__), tag)
-#define Z_LOG_INFO_T(tag, message, ...)       if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Info, tag)) logger.log(zero::log::Level::Info, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__), tag)
-#define Z_LOG_WARNING_T(tag, message, ...)    if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Warning, tag)) logger.log(zero::log::Level::Warning, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__), tag)
-#define Z_LOG_ERROR_T(tag, message, ...)      if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Error, tag)) logger.log(zero::log::Level::Error, zero::log::sourceFilename(__FILE__), __LINE__, fmt::format(message, ## __VA_ARGS__), tag)
+#define Z_LOG_DEBUG_T(tag, message, ...)      if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Debug, tag)) logger.log(zero::log::Level::Debug, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__), tag)
+#define Z_LOG_INFO_T(tag, message, ...)       if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Info, tag)) logger.log(zero::log::Level::Info, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__), tag)
+#define Z_LOG_WARNING_T(tag, message, ...)    if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Warning, tag)) logger.log(zero::log::Level::Warning, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__), tag)
+#define Z_LOG_ERROR_T(tag, message, ...)      if (auto &logger = Z_GLOBAL_LOGGER; logger.enabled(zero::log::Level::Error, tag)) logger.log(zero::log::Level::Error, zero::log::sourceFilename(__FILE__), __LINE__, zero::log::makeMessage(message, ## __VA_ARGS__), tag)
 
 #endif //ZERO_LOG_H
@@ -0,0 +1,147 @@
+#include <zero/async/cancellation.h>
+#include <map>
+#include <mutex>
+#include <optional>
+
+struct zero::async::CancellationSubscription::State {
+    std::mutex mutex;
+    bool cancelled{false};
+    std::uint64_t counter{0};
+    std::map<std::uint64_t, SmallFunction<void()>> callbacks;
+    // keeps a child source subscribed to its parent for as long as the child exists
+    std::optional<CancellationSubscription> parent;
+};
+
+zero::async::CancellationSubscription::CancellationSubscription(std::shared_ptr<State> state, const std::uint64_t id)
+    : mState{std::move(state)}, mID{id} {
+}
+
+zero::async::CancellationSubscription::CancellationSubscription(CancellationSubscription &&rhs) noexcept
+    : mState{std::move(rhs.mState)}, mID{std::exchange(rhs.mID, 0)} {
+}
+
+zero::async::CancellationSubscription &
+zero::async::CancellationSubscription::operator=(CancellationSubscription &&rhs) noexcept {
+    if (this == &rhs)
+        return *this;
+
+    reset();
+
+    mState = std::move(rhs.mState);
+    mID = std::exchange(rhs.mID, 0);
+
+    return *this;
+}
+
+zero::async::CancellationSubscription::~CancellationSubscription() {
+    reset();
+}
+
+void zero::async::CancellationSubscription::reset() {
+    if (!mState)
+        return;
+
+    SmallFunction<void()> callback;
+
+    {
+        std::lock_guard guard{mState->mutex};
+
+        if (const auto it = mState->callbacks.find(mID); it != mState->callbacks.end()) {
+            callback = std::move(it->second);
+            mState->callbacks.erase(it);
+        }
+    }
+
+    mState.reset();
+    mID = 0;
+}
+
+zero::async::CancellationSource::CancellationSource() : mState{std::make_shared<State>()} {
+}
+
+zero::async::CancellationSource::CancellationSource(std::shared_ptr<State> state) : mState{std::move(state)} {
+}
+
+zero::async::CancellationSource::CancellationSource(const CancellationToken &parent) : CancellationSource{} {
+    if (!parent.cancellable())
+        return;
+
+    mState->parent = parent.subscribe([state = std::weak_ptr{mState}] {
+        if (const auto child = state.lock())
+            CancellationSource{child}.cancel();
+    });
+}
+
+bool zero::async::CancellationSource::cancel() {
+    {
+        std::lock_guard guard{mState->mutex};
+
+        if (mState->cancelled)
+            return false;
+
+        mState->cancelled = true;
+    }
+
+    // callbacks are popped one at a time, so they are free to subscribe or unsubscribe while running
+    while (true) {
+        SmallFunction<void()> callback;
+
+        {
+            std::lock_guard guard{mState->mutex};
+
+            if (mState->callbacks.empty())
+                break;
+
+            const auto it = mState->callbacks.begin();
+            callback = std::move(it->second);
+            mState->callbacks.erase(it);
+        }
+
+        callback();
+    }
+
+    return true;
+}
+
+bool zero::async::CancellationSource::cancelled() const {
+    std::lock_guard guard{mState->mutex};
+    return mState->cancelled;
+}
+
+zero::async::CancellationToken zero::async::CancellationSource::token() const {
+    return CancellationToken{mState};
+}
+
+zero::async::CancellationToken::CancellationToken(std::shared_ptr<State> state) : mState{std::move(state)} {
+}
+
+bool zero::async::CancellationToken::cancellable() const {
+    return mState != nullptr;
+}
+
+bool zero::async::CancellationToken::cancelled() const {
+    if (!mState)
+        return false;
+
+    std::lock_guard guard{mState->mutex};
+    return mState->cancelled;
+}
+
+zero::async::CancellationSubscription
+zero::async::CancellationToken::subscribe(SmallFunction<void()> callback) const {
+    if (!mState)
+        return {};
+
+    {
+        std::lock_guard guard{mState->mutex};
+
+        if (!mState->cancelled) {
+            const auto id = ++mState->counter;
+            mState->callbacks.emplace(id, std::move(callback));
+            return {mState, id};
+        }
+    }
+
+    callback();
+    return {};
+}
@@ -1,4 +1,32 @@
 #include <zero/async/promise.h>
+#include <zero/atomic/work_stealing_deque.h>
+#include <algorithm>
+
+namespace {
+    // Every N-th lookup a worker polls the global injection queue before its own deque, so that tasks posted from
+    // outside the pool cannot be starved by workers that keep feeding themselves.
+    constexpr auto InjectionInterval = 61;
+    // Upper bound of the finished task nodes a worker keeps for reuse.
+    constexpr std::size_t MaxCachedTasks = 1024;
+}
+
+Z_DEFINE_ERROR_CATEGORY_INSTANCES(zero::async::promise::TimeoutError, zero::async::promise::TaskError)
+
+struct zero::async::promise::ThreadPoolExecutor::Task {
+    SmallFunction<void()> function;
+    Task *next{};
+};
+
+struct zero::async::promise::ThreadPoolExecutor::Worker {
+    ThreadPoolExecutor *executor{};
+    std::size_t index{};
+    std::size_t tick{};
+    atomic::WorkStealingDeque<Task *> deque;
+    // Finished task nodes, only touched by the worker thread itself.
+    Task *free{};
+    std::size_t cached{};
+    std::thread thread;
+};
 
 std::shared_ptr<zero::async::promise::InlineExecutor> zero::async::promise::InlineExecutor::instance() {
     static const auto instance = std::make_shared<InlineExecutor>();
@@ -8,3 +36,214 @@ std::shared_ptr<zero::async::promise::InlineExecutor> zero::async::promise::Inli
 void zero::async::promise::InlineExecutor::post(const std::function<void()> f) {
     f();
 }
+
+void zero::async::promise::InlineExecutor::post(SmallFunction<void()> task) {
+    task();
+}
+
+zero::async::promise::ThreadPoolExecutor::ThreadPoolExecutor(const std::size_t concurrency)
+    : mStopped{false}, mInjection{nullptr}, mSleeping{0}, mEpoch{0} {
+    const auto n = std::max<std::size_t>(concurrency, 1);
+
+    for (std::size_t i{0}; i < n; ++i)
+        mWorkers.push_back(std::make_unique<Worker>(this, i));
+
+    for (const auto &worker: mWorkers)
+        worker->thread = std::thread{&ThreadPoolExecutor::dispatch, this, worker->index};
+}
+
+zero::async::promise::ThreadPoolExecutor::~ThreadPoolExecutor() {
+    mStopped = true;
+    ++mEpoch;
+    mEpoch.notify_all();
+
+    for (const auto &worker: mWorkers) {
+        // a task running on one of our workers may release the last reference, that worker cannot join itself
+        if (worker.get() == current()) {
+            worker->thread.detach();
+            current() = nullptr;
+            continue;
+        }
+
+        worker->thread.join();
+    }
+
+    for (const auto &worker: mWorkers) {
+        while (const auto task = worker->deque.pop())
+            delete *task;
+
+        while (worker->free)
+            delete std::exchange(worker->free, worker->free->next);
+    }
+
+    auto task = mInjection.exchange(nullptr);
+
+    while (task)
+        delete std::exchange(task, task->next);
+}
+
+void zero::async::promise::ThreadPoolExecutor::dispatch(const std::size_t index) {
+    auto &worker = *mWorkers[index];
+    current() = &worker;
+
+    while (true) {
+        if (const auto task = find(worker)) {
+            task->function();
+            // the captures may hold the last reference to the executor, release them before checking
+            task->function = nullptr;
+
+            // the executor has been destroyed by the task and detached this thread
+            if (!current()) {
+                delete task;
+                return;
+            }
+
+            recycle(worker, task);
+            continue;
+        }
+
+        // announce the intention to sleep before the final check, post() wakes us up if it observes a sleeper
+        ++mSleeping;
+        const auto epoch = mEpoch.load();
+
+        if (const auto task = find(worker)) {
+            --mSleeping;
+            task->function();
+            task->function = nullptr;
+
+            if (!current()) {
+                delete task;
+                return;
+            }
+
+            recycle(worker, task);
+            continue;
+        }
+
+        if (mStopped) {
+            --mSleeping;
+            break;
+        }
+
+        mEpoch.wait(epoch);
+        --mSleeping;
+    }
+
+    current() = nullptr;
+}
+
+zero::async::promise::ThreadPoolExecutor::Worker *&zero::async::promise::ThreadPoolExecutor::current() {
+    thread_local Worker *worker{nullptr};
+    return worker;
+}
+
+// Posting from a worker takes the node back from its free-list, so a task that keeps feeding its own worker stops
+// allocating once the list is warm. Nodes posted from outside the pool still come from the global allocator.
+void zero::async::promise::ThreadPoolExecutor::recycle(Worker &worker, Task *task) {
+    if (worker.cached >= MaxCachedTasks) {
+        delete task;
+        return;
+    }
+
+    task->next = std::exchange(worker.free, task);
+    ++worker.cached;
+}
+
+void zero::async::promise::ThreadPoolExecutor::wake() {
+    if (mSleeping == 0)
+        return;
+
+    ++mEpoch;
+    mEpoch.notify_one();
+}
+
+zero::async::promise::ThreadPoolExecutor::Task *zero::async::promise::ThreadPoolExecutor::find(Worker &worker) {
+    if (++worker.tick % InjectionInterval == 0) {
+        if (const auto task = inject(worker))
+            return task;
+    }
+
+    if (const auto task = worker.deque.pop())
+        return *task;
+
+    if (const auto task = inject(worker))
+        return task;
+
+    return steal(worker);
+}
+
+zero::async::promise::ThreadPoolExecutor::Task *zero::async::promise::ThreadPoolExecutor::inject(Worker &worker) {
+    if (!mInjection.load(std::memory_order_relaxed))
+        return nullptr;
+
+    auto task = mInjection.exchange(nullptr, std::memory_order_acquire);
+
+    if (!task)
+        return nullptr;
+
+    // the injection list is LIFO, pushing it newest first lets the owner pop the remaining tasks oldest first
+    while (task->next)
+        worker.deque.push(std::exchange(task, task->next));
+
+    if (!worker.deque.empty())
+        wake();
+
+    return task;
+}
+
+zero::async::promise::ThreadPoolExecutor::Task *zero::async::promise::ThreadPoolExecutor::steal(const Worker &worker) {
+    const auto n = mWorkers.size();
+
+    for (std::size_t i{0}; i < n; ++i) {
+        auto &victim = *mWorkers[(worker.tick + i) % n];
+
+        if (&victim == &worker)
+            continue;
+
+        if (const auto task = victim.deque.steal()) {
+            if (!victim.deque.empty())
+                wake();
+
+            return *task;
+        }
+    }
+
+    return nullptr;
+}
+
+void zero::async::promise::ThreadPoolExecutor::post(std::function<void()> f) {
+    post(SmallFunction<void()>{std::move(f)});
+}
+
+void zero::async::promise::ThreadPoolExecutor::post(SmallFunction<void()> function) {
+    if (const auto worker = current(); worker && worker->executor == this) {
+        Task *task;
+
+        if (worker->free) {
+            task = std::exchange(worker->free, worker->free->next);
+            task->function = std::move(function);
+            task->next = nullptr;
+            --worker->cached;
+        }
+        else {
+            task = new Task{std::move(function)};
+        }
+
+        worker->deque.push(task);
+    }
+    else {
+        const auto task = new Task{std::move(function)};
+        task->next = mInjection.load(std::memory_order_relaxed);
+
+        while (!mInjection.compare_exchange_weak(task->next, task, std::memory_order_release)) {
+        }
+    }
+
+    // pairs with the sleeper registration in dispatch(), either we observe the sleeper or it observes the task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wake();
+}
+
+std::size_t zero::async::promise::ThreadPoolExecutor::concurrency() const {
+    return mWorkers.size();
+}
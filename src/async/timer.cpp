@@ -0,0 +1,200 @@
+#include <zero/async/timer.h>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    constexpr auto Mask = zero::async::TimerWheel::Slots - 1;
+
+    constexpr std::uint64_t span(const std::size_t level) {
+        return std::uint64_t{1} << zero::async::TimerWheel::SlotBits * level;
+    }
+}
+
+zero::async::TimerWheel::TimerWheel(const std::chrono::milliseconds tick)
+    : mStopped{false}, mTick{std::max(tick, std::chrono::milliseconds{1})}, mEpoch{Clock::now()}, mCurrent{0},
+      mWake{std::numeric_limits<std::uint64_t>::max()}, mCounter{0}, mSlots{} {
+    mThread = std::thread{&TimerWheel::dispatch, this};
+}
+
+zero::async::TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard guard{mMutex};
+        mStopped = true;
+    }
+
+    mCondition.notify_one();
+    assert(mThread.get_id() != std::this_thread::get_id());
+    mThread.join();
+}
+
+std::shared_ptr<zero::async::TimerWheel> zero::async::TimerWheel::instance() {
+    static const auto instance = std::make_shared<TimerWheel>();
+    return instance;
+}
+
+void zero::async::TimerWheel::dispatch() {
+    std::vector<SmallFunction<void()>> expired;
+    std::unique_lock lock{mMutex};
+
+    while (!mStopped) {
+        if (mTimers.empty()) {
+            mWake = std::numeric_limits<std::uint64_t>::max();
+            mCondition.wait(lock);
+            continue;
+        }
+
+        const auto now = elapsed();
+
+        while (mCurrent < now)
+            advance(expired);
+
+        if (!expired.empty()) {
+            lock.unlock();
+
+            for (auto &callback: expired)
+                callback();
+
+            expired.clear();
+            lock.lock();
+            continue;
+        }
+
+        mWake = next();
+        mCondition.wait_until(lock, mEpoch + mTick * mWake);
+    }
+}
+
+// Timers are placed by their distance from the current tick, a timer on level `n` is cascaded into a lower level once
+// the current tick reaches the start of its slot, which is never later than its deadline.
+void zero::async::TimerWheel::link(Node &node) {
+    const auto delta = node.deadline > mCurrent ? node.deadline - mCurrent : 0;
+    auto deadline = node.deadline;
+    std::size_t level{0};
+
+    while (level < Levels - 1 && delta >= span(level + 1))
+        ++level;
+
+    // deadlines beyond the range of the top level are parked in its farthest slot and re-linked on cascade
+    if (delta >= span(Levels))
+        deadline = mCurrent + span(Levels) - 1;
+
+    node.level = level;
+    node.slot = (deadline >> SlotBits * level) & Mask;
+    node.prev = nullptr;
+    node.next = mSlots[level][node.slot];
+
+    if (node.next)
+        node.next->prev = &node;
+
+    mSlots[level][node.slot] = &node;
+}
+
+void zero::async::TimerWheel::unlink(Node &node) {
+    if (node.prev)
+        node.prev->next = node.next;
+    else
+        mSlots[node.level][node.slot] = node.next;
+
+    if (node.next)
+        node.next->prev = node.prev;
+
+    node.prev = nullptr;
+    node.next = nullptr;
+}
+
+void zero::async::TimerWheel::advance(std::vector<SmallFunction<void()>> &expired) {
+    ++mCurrent;
+
+    for (std::size_t level{1}; level < Levels; ++level) {
+        if (mCurrent & (span(level) - 1))
+            break;
+
+        auto node = std::exchange(mSlots[level][(mCurrent >> SlotBits * level) & Mask], nullptr);
+
+        while (node) {
+            const auto next = node->next;
+            link(*node);
+            node = next;
+        }
+    }
+
+    auto node = std::exchange(mSlots[0][mCurrent & Mask], nullptr);
+
+    while (node) {
+        const auto next = node->next;
+        assert(node->deadline <= mCurrent);
+        expired.push_back(std::move(node->callback));
+        mTimers.erase(node->id);
+        node = next;
+    }
+}
+
+std::uint64_t zero::async::TimerWheel::elapsed() const {
+    return static_cast<std::uint64_t>((Clock::now() - mEpoch) / mTick);
+}
+
+// The nearest tick that either expires timers on the lowest level or cascades a higher one.
+std::uint64_t zero::async::TimerWheel::next() const {
+    auto tick = mCurrent + 1;
+
+    while ((tick & Mask) != 0 && !mSlots[0][tick & Mask])
+        ++tick;
+
+    return tick;
+}
+
+zero::async::TimerWheel::TimerID
+zero::async::TimerWheel::add(const std::chrono::milliseconds delay, SmallFunction<void()> callback) {
+    const auto duration = std::max(delay, std::chrono::milliseconds{0});
+    const auto ticks = static_cast<std::uint64_t>((duration + mTick - std::chrono::milliseconds{1}) / mTick);
+
+    std::unique_lock lock{mMutex};
+
+    const auto now = elapsed();
+
+    // nothing is pending, so the wheel can jump forward instead of stepping through the idle ticks
+    if (mTimers.empty())
+        mCurrent = now;
+
+    const auto id = ++mCounter;
+    auto &node = mTimers[id];
+
+    node.id = id;
+    // the current tick has already partially elapsed, rounding up keeps the callback from firing early
+    node.deadline = now + ticks + 1;
+    node.callback = std::move(callback);
+
+    link(node);
+
+    if (node.deadline >= mWake)
+        return id;
+
+    lock.unlock();
+    mCondition.notify_one();
+
+    return id;
+}
+
+bool zero::async::TimerWheel::cancel(const TimerID id) {
+    std::lock_guard guard{mMutex};
+
+    const auto it = mTimers.find(id);
+
+    if (it == mTimers.end())
+        return false;
+
+    unlink(it->second);
+    mTimers.erase(it);
+
+    return true;
+}
+
+std::size_t zero::async::TimerWheel::size() const {
+    std::lock_guard guard{mMutex};
+    return mTimers.size();
+}
+
+std::chrono::milliseconds zero::async::TimerWheel::tick() const {
+    return mTick;
+}
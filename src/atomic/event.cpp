@@ -1,20 +1,18 @@
 #include <zero/atomic/event.h>
 #include <zero/defer.h>
+#include <zero/error.h>
+#include <zero/expect.h>
 #include <cassert>
 
 #ifdef _WIN32
-#include <zero/expect.h>
 #include <zero/os/windows/error.h>
 #elifdef __linux__
 #include <climits>
 #include <unistd.h>
 #include <syscall.h>
 #include <linux/futex.h>
-#include <zero/error.h>
 #include <zero/os/unix/error.h>
 #elifdef __APPLE__
-#include <zero/error.h>
-#include <zero/expect.h>
 #include <zero/os/unix/error.h>
 
 constexpr auto ULFWakeAll = 0x00000100;
@@ -24,77 +22,96 @@ extern "C" int __ulock_wait(uint32_t operation, void *addr, uint64_t value, uint
 extern "C" int __ulock_wake(uint32_t operation, void *addr, uint64_t wake_value);
 #endif
 
-zero::atomic::Event::Event(const bool manual, const bool initialState) : mManual{manual}, mState(initialState ? 1 : 0) {
-}
-
-std::expected<void, std::error_code> zero::atomic::Event::wait(const std::optional<std::chrono::milliseconds> timeout) {
-    assert(mWaiterCount >= 0);
-
-    while (true) {
-        if (mManual) {
-            if (mState)
-                return {};
-        }
-        else {
-            if (Value expected{1}; mState.compare_exchange_strong(expected, 0))
-                return {};
-        }
-
-        ++mWaiterCount;
-        Z_DEFER(--mWaiterCount);
-
+namespace {
+    // Blocks while `address` still holds `value`, spurious wake-ups are reported as success.
+    template<typename T>
+    std::expected<void, std::error_code>
+    park(std::atomic<T> &address, T value, const std::optional<std::chrono::milliseconds> timeout) {
 #ifdef _WIN32
-        Z_EXPECT(os::windows::expected([&] {
-            Value expected{0};
+        Z_EXPECT(zero::os::windows::expected([&] {
             return WaitOnAddress(
-                &mState,
-                &expected,
-                sizeof(Value),
+                &address,
+                &value,
+                sizeof(T),
                 timeout ? static_cast<DWORD>(timeout->count()) : INFINITE
             );
         }));
 #elifdef __linux__
-        std::optional<timespec> ts;
+        // an absolute deadline on the monotonic clock, so that retrying after a signal does not restart the timeout
+        std::optional<timespec> deadline;
 
-        if (timeout)
-            ts = {
-                .tv_sec = static_cast<decltype(timespec::tv_sec)>(timeout->count() / 1000),
-                .tv_nsec = static_cast<decltype(timespec::tv_nsec)>(timeout->count() % 1000 * 1000000)
+        if (timeout) {
+            const auto time = std::chrono::steady_clock::now().time_since_epoch() + *timeout;
+            const auto seconds = duration_cast<std::chrono::seconds>(time);
+
+            deadline = {
+                .tv_sec = static_cast<decltype(timespec::tv_sec)>(seconds.count()),
+                .tv_nsec = static_cast<decltype(timespec::tv_nsec)>(
+                    duration_cast<std::chrono::nanoseconds>(time - seconds).count()
+                )
             };
+        }
 
-        if (const auto result = os::unix::ensure([&] {
-            return syscall(SYS_futex, &mState, FUTEX_WAIT, 0, ts ? &*ts : nullptr, nullptr, 0);
+        if (const auto result = zero::os::unix::ensure([&] {
+            return syscall(
+                SYS_futex,
+                &address,
+                FUTEX_WAIT_BITSET,
+                value,
+                deadline ? &*deadline : nullptr,
+                nullptr,
+                FUTEX_BITSET_MATCH_ANY
+            );
         }); !result && result.error() != std::errc::resource_unavailable_try_again)
             return std::unexpected{result.error()};
 #elifdef __APPLE__
-        Z_EXPECT(os::unix::ensure([&] {
-            return __ulock_wait(
-                ULCompareAndWait,
-                &mState,
-                0,
-                !timeout ? 0 : duration_cast<std::chrono::microseconds>(*timeout).count()
-            );
-        }));
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+
+        if (timeout)
+            deadline = std::chrono::steady_clock::now() + *timeout;
+
+        // retried by hand after a signal, with the time that is left
+        while (true) {
+            std::uint64_t remaining{0};
+
+            if (deadline) {
+                remaining = std::max<std::int64_t>(
+                    duration_cast<std::chrono::microseconds>(*deadline - std::chrono::steady_clock::now()).count(),
+                    0
+                );
+
+                // zero would wait forever
+                if (remaining == 0)
+                    return std::unexpected{std::make_error_code(std::errc::timed_out)};
+            }
+
+            const auto result = zero::os::unix::expected([&] {
+                return __ulock_wait(ULCompareAndWait, &address, value, remaining);
+            });
+
+            if (result)
+                break;
+
+            if (result.error() != std::errc::interrupted)
+                return std::unexpected{result.error()};
+        }
 #else
 #error "unsupported platform"
 #endif
+        return {};
     }
-}
-
-void zero::atomic::Event::set() {
-    if (Value expected{0}; mState.compare_exchange_strong(expected, 1)) {
-        if (mWaiterCount == 0)
-            return;
 
+    template<typename T>
+    void wake(std::atomic<T> &address) {
 #ifdef _WIN32
-        WakeByAddressAll(&mState);
+        WakeByAddressAll(&address);
 #elifdef __linux__
-        error::guard(os::unix::expected([this] {
-            return syscall(SYS_futex, &mState, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        zero::error::guard(zero::os::unix::expected([&] {
+            return syscall(SYS_futex, &address, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
         }));
 #elifdef __APPLE__
-        error::guard(os::unix::expected([this] {
-            return __ulock_wake(ULCompareAndWait | ULFWakeAll, &mState, 0);
+        zero::error::guard(zero::os::unix::expected([&] {
+            return __ulock_wake(ULCompareAndWait | ULFWakeAll, &address, 0);
         }).or_else([](const auto &ec) -> std::expected<int, std::error_code> {
             if (ec != std::errc::no_such_file_or_directory)
                 return std::unexpected{ec};
@@ -107,6 +124,37 @@ void zero::atomic::Event::set() {
     }
 }
 
+zero::atomic::Event::Event(const bool manual, const bool initialState) : mManual{manual}, mState(initialState ? 1 : 0) {
+}
+
+std::expected<void, std::error_code> zero::atomic::Event::wait(const std::optional<std::chrono::milliseconds> timeout) {
+    assert(mWaiterCount >= 0);
+
+    while (true) {
+        if (mManual) {
+            if (mState)
+                return {};
+        }
+        else {
+            if (Value expected{1}; mState.compare_exchange_strong(expected, 0))
+                return {};
+        }
+
+        ++mWaiterCount;
+        Z_DEFER(--mWaiterCount);
+        Z_EXPECT(park(mState, Value{0}, timeout));
+    }
+}
+
+void zero::atomic::Event::set() {
+    if (Value expected{0}; mState.compare_exchange_strong(expected, 1)) {
+        if (mWaiterCount == 0)
+            return;
+
+        wake(mState);
+    }
+}
+
 void zero::atomic::Event::reset() {
     mState = 0;
 }
@@ -114,3 +162,44 @@ void zero::atomic::Event::reset() {
 bool zero::atomic::Event::isSet() const {
     return mState == 1;
 }
+
+zero::atomic::EventCount::EventCount() : mEpoch{0}, mWaiterCount{0} {
+}
+
+// The lowest bit of the epoch marks it as armed by a waiter, the epoch is armed after registering, so a notification
+// racing with the waiter's re-check either sees the waiter, or happens early enough for the re-check to observe it.
+zero::atomic::EventCount::Key zero::atomic::EventCount::prepare() {
+    ++mWaiterCount;
+    return mEpoch.fetch_or(1) | 1;
+}
+
+void zero::atomic::EventCount::cancel() {
+    assert(mWaiterCount > 0);
+    --mWaiterCount;
+}
+
+std::expected<void, std::error_code>
+zero::atomic::EventCount::wait(const Key key, const std::optional<std::chrono::milliseconds> timeout) {
+    assert(mWaiterCount > 0);
+    Z_DEFER(--mWaiterCount);
+    return park(mEpoch, key, timeout);
+}
+
+// Only the first notification after the epoch was armed pays for the wake-up, later ones return until a woken waiter
+// arms it again, instead of issuing a syscall each while it has yet to be scheduled.
+void zero::atomic::EventCount::notify() {
+    // pairs with the seq_cst increment in prepare(): the caller may have published its change with a release store
+    // only, which could otherwise be ordered after the load of the waiter count, and a waiter registering in between
+    // would then miss both
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (mWaiterCount == 0)
+        return;
+
+    auto epoch = mEpoch.load();
+
+    if (!(epoch & 1) || !mEpoch.compare_exchange_strong(epoch, epoch + 1))
+        return;
+
+    wake(mEpoch);
+}
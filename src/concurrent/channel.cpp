@@ -1,9 +1,43 @@
-#include <zero/concurrent/channel.h>
-
-Z_DEFINE_ERROR_CATEGORY_INSTANCES(
-    zero::concurrent::TrySendError,
-    zero::concurrent::SendError,
-    zero::concurrent::TryReceiveError,
-    zero::concurrent::ReceiveError,
-    zero::concurrent::ChannelError
-)
+#include <zero/concurrent/channel.h>
+#include <algorithm>
+
+void zero::concurrent::SelectWaiters::add(atomic::Event &event) {
+    std::lock_guard guard{mMutex};
+    mEvents.push_back(&event);
+    ++mCount;
+}
+
+void zero::concurrent::SelectWaiters::remove(atomic::Event &event) {
+    std::lock_guard guard{mMutex};
+    mEvents.erase(std::ranges::find(mEvents, &event));
+    --mCount;
+}
+
+void zero::concurrent::SelectWaiters::wake() {
+    std::lock_guard guard{mMutex};
+
+    for (const auto &event: mEvents)
+        event->set();
+}
+
+zero::concurrent::ChannelStats::Snapshot zero::concurrent::ChannelStats::snapshot() const {
+    return {
+        mHighWaterMark.load(std::memory_order_relaxed),
+        mSender.transferred.load(std::memory_order_relaxed),
+        mReceiver.transferred.load(std::memory_order_relaxed),
+        mSender.parks.load(std::memory_order_relaxed),
+        mReceiver.parks.load(std::memory_order_relaxed),
+        std::chrono::nanoseconds{mSender.parkTime.load(std::memory_order_relaxed)},
+        std::chrono::nanoseconds{mReceiver.parkTime.load(std::memory_order_relaxed)},
+        mSender.retries.load(std::memory_order_relaxed),
+        mReceiver.retries.load(std::memory_order_relaxed)
+    };
+}
+
+Z_DEFINE_ERROR_CATEGORY_INSTANCES(
+    zero::concurrent::TrySendError,
+    zero::concurrent::SendError,
+    zero::concurrent::TryReceiveError,
+    zero::concurrent::ReceiveError,
+    zero::concurrent::ChannelError
+)
@@ -1,17 +1,186 @@
 #include <zero/log.h>
 #include <zero/env.h>
+#include <zero/error.h>
 #include <zero/strings.h>
 #include <zero/filesystem.h>
 #include <ranges>
+#include <typeinfo>
 #include <algorithm>
 
-constexpr auto LoggerBufferSize = 1024;
+constexpr auto StagingBufferSize = 256;
 constexpr auto NoSinkSentinel = -1;
 
+namespace {
+    std::atomic<std::uint64_t> nextLoggerID{0};
+
+    // Hazard pointers of the threads reading the snapshots loggers publish. A thread protects at most one snapshot of
+    // each kind at a time, of whichever logger it is reading, so one slot per kind and thread is enough.
+    enum HazardKind : std::size_t {
+        TagLevelHazard,
+        TagLimitHazard,
+        HazardKinds
+    };
+
+    struct HazardRegistry {
+        std::mutex mutex;
+        std::list<std::atomic<const void *> *> slots;
+    };
+
+    // Intentionally leaked, threads may still exit after static destructors have run.
+    HazardRegistry &hazardRegistry() {
+        static const auto instance = new HazardRegistry();
+        return *instance;
+    }
+
+    struct Hazard {
+        Hazard() {
+            auto &registry = hazardRegistry();
+            const std::lock_guard guard{registry.mutex};
+
+            for (auto &pointer: pointers)
+                registry.slots.push_back(&pointer);
+        }
+
+        Hazard(const Hazard &) = delete;
+        Hazard &operator=(const Hazard &) = delete;
+
+        ~Hazard() {
+            destroyed() = true;
+
+            auto &registry = hazardRegistry();
+            const std::lock_guard guard{registry.mutex};
+
+            for (auto &pointer: pointers)
+                registry.slots.remove(&pointer);
+        }
+
+        static bool &destroyed() {
+            thread_local bool flag{false};
+            return flag;
+        }
+
+        std::array<std::atomic<const void *>, HazardKinds> pointers{};
+    };
+
+    // `nullptr` once the slots of this thread have been destroyed at its exit.
+    std::atomic<const void *> *hazard(const HazardKind kind) {
+        if (Hazard::destroyed())
+            return nullptr;
+
+        thread_local Hazard instance;
+        return &instance.pointers[kind];
+    }
+
+    // Loads `source` and publishes it as the hazard of this thread, which keeps it from being freed until the slot is
+    // pointed at another snapshot.
+    template<typename T>
+    const T *protect(const std::atomic<const T *> &source, std::atomic<const void *> &slot) {
+        auto pointer = source.load();
+
+        while (true) {
+            slot.store(pointer);
+
+            // pairs with the fence in reclaim(), either it sees our hazard or we see the snapshot replacing this one
+            if (const auto current = source.load(); current != pointer) {
+                pointer = current;
+                continue;
+            }
+
+            return pointer;
+        }
+    }
+
+    // Frees every snapshot but the current one, the last, that no thread has a hazard on. Whatever is kept is tried
+    // again on the next call, so at most one snapshot per thread that has read one outlives it.
+    template<typename T>
+    void reclaim(std::list<std::unique_ptr<const T>> &snapshots) {
+        if (snapshots.size() < 2)
+            return;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::vector<const void *> hazards;
+
+        {
+            auto &registry = hazardRegistry();
+            const std::lock_guard guard{registry.mutex};
+
+            for (const auto &slot: registry.slots)
+                hazards.push_back(slot->load());
+        }
+
+        snapshots.remove_if([&, current = snapshots.back().get()](const auto &snapshot) {
+            return snapshot.get() != current && !std::ranges::contains(hazards, snapshot.get());
+        });
+    }
+
+    // Replaces the snapshot readers load from `current`, called with the lock of the writers held.
+    template<typename T>
+    void publish(
+        std::atomic<const T *> &current,
+        std::list<std::unique_ptr<const T>> &snapshots,
+        std::unique_ptr<const T> snapshot
+    ) {
+        current.store(snapshot.get());
+        snapshots.push_back(std::move(snapshot));
+        reclaim(snapshots);
+    }
+
+    // Called by a logger that goes away with its snapshots: a slot still pointing at one of them would otherwise
+    // vouch for an unrelated snapshot allocated at the same address later on, without it ever having been protected.
+    template<typename T>
+    void retire(const std::list<std::unique_ptr<const T>> &snapshots) {
+        auto &registry = hazardRegistry();
+        const std::lock_guard guard{registry.mutex};
+
+        for (const auto &slot: registry.slots) {
+            for (const auto &snapshot: snapshots) {
+                auto expected = static_cast<const void *>(snapshot.get());
+
+                // the slot belongs to another thread, but that thread cannot be reading from a logger being destroyed
+                if (slot->compare_exchange_strong(expected, nullptr))
+                    break;
+            }
+        }
+    }
+
+    // Calls `f` with the current snapshot, under the hazard of this thread, or under `mutex` once the hazard is gone.
+    // The hazard is left on the snapshot afterwards, so as long as it is not replaced, a read costs an acquire load
+    // and a comparison against the slot of this thread, and only a replaced snapshot has to be protected anew.
+    template<typename T, typename F>
+    auto read(const std::atomic<const T *> &source, std::mutex &mutex, const HazardKind kind, F &&f) {
+        const auto slot = hazard(kind);
+
+        if (!slot) {
+            const std::lock_guard guard{mutex};
+            return std::invoke(std::forward<F>(f), *source.load());
+        }
+
+        auto pointer = source.load(std::memory_order_acquire);
+
+        if (pointer != slot->load(std::memory_order_relaxed))
+            pointer = protect(source, *slot);
+
+        return std::invoke(std::forward<F>(f), *pointer);
+    }
+}
+
+void zero::log::ISink::writeBatch(const std::span<const Record> records) {
+    for (const auto &record: records)
+        write(record);
+}
+
 void zero::log::ConsoleSink::write(const Record &record) {
-    const auto message = fmt::format("{}\n", record);
+    writeBatch(std::span{&record, 1});
+}
+
+void zero::log::ConsoleSink::writeBatch(const std::span<const Record> records) {
+    fmt::memory_buffer buffer;
 
-    if (fwrite(message.data(), 1, message.size(), stderr) != message.size())
+    for (const auto &record: records)
+        fmt::format_to(std::back_inserter(buffer), "{}\n", record);
+
+    if (fwrite(buffer.data(), 1, buffer.size(), stderr) != buffer.size())
         throw error::StacktraceError<std::system_error>{errno, std::generic_category()};
 }
 
@@ -79,126 +248,408 @@ std::string zero::log::FileSink::encode(const Record &record) const {
     return fmt::format("{}\n", record);
 }
 
-void zero::log::FileSink::write(const Record &record) {
-    const auto message = encode(record);
-
-    if (!mStream.write(message.c_str(), static_cast<std::streamsize>(message.size())))
+void zero::log::FileSink::output(const std::string_view data) {
+    if (!mStream.write(data.data(), static_cast<std::streamsize>(data.size())))
         throw error::StacktraceError<std::system_error>{errno, std::generic_category()};
 
-    mPosition += message.size();
+    mPosition += data.size();
+}
+
+void zero::log::FileSink::write(const Record &record) {
+    output(encode(record));
 
     if (mPosition >= mMaxFileSize)
         rotate();
 }
 
+// Formats the records straight into a single buffer, which is only written out early where a file has to be rotated.
+void zero::log::FileSink::writeBatch(const std::span<const Record> records) {
+    if (typeid(*this) != typeid(FileSink)) {
+        ISink::writeBatch(records);
+        return;
+    }
+
+    std::size_t size{0};
+
+    // the timestamp, level and separators take up about 40 bytes, the file name and line number are padded to 25
+    for (const auto &record: records)
+        size += record.content.size() + std::max(record.filename.size(), 20uz) + 48;
+
+    fmt::memory_buffer buffer;
+    buffer.reserve(size);
+
+    for (const auto &record: records) {
+        fmt::format_to(std::back_inserter(buffer), "{}\n", record);
+
+        if (mPosition + buffer.size() < mMaxFileSize)
+            continue;
+
+        output({buffer.data(), buffer.size()});
+        buffer.clear();
+        rotate();
+    }
+
+    output({buffer.data(), buffer.size()});
+}
+
 void zero::log::FileSink::flush() {
     if (!mStream.flush().good())
         throw error::StacktraceError<std::system_error>{errno, std::generic_category()};
 }
 
-zero::log::Logger::Logger() : mMaxLogLevel{NoSinkSentinel}, mPending{0},
-                              mChannel{concurrent::channel<Record>(LoggerBufferSize)} {
+zero::log::Logger::Logger()
+    : mMaxLogLevel{NoSinkSentinel}, mTagLevels{nullptr}, mPending{0}, mID{nextLoggerID++}, mClosed{false},
+      mOverflowPolicy{OverflowPolicy::Block}, mTagLimits{nullptr}, mOverflowed{0}, mSampled{0} {
 }
 
 zero::log::Logger::~Logger() {
-    mChannel.first.close();
+    mClosed = true;
+    mEvent.notify();
 
     if (mThread.joinable())
         mThread.join();
+
+    for (const auto &ring: mStaging)
+        ring->closed.store(true, std::memory_order_release);
+
+    retire(mTagLevelSnapshots);
+    retire(mTagLimitSnapshots);
 }
 
-void zero::log::Logger::consume() {
-    auto &receiver = mChannel.second;
+// Each thread logs into a ring of its own, so producers never contend with each other. The ring is shared between the
+// thread and the logger, whichever of them goes away first closes it, and the other one lets go of it once it sees that.
+zero::log::Logger::Staging &zero::log::Logger::staging() {
+    struct Rings {
+        Rings() = default;
+        Rings(const Rings &) = delete;
+        Rings &operator=(const Rings &) = delete;
+
+        // the thread exits, it cannot stage anything anymore
+        ~Rings() {
+            for (const auto &ring: list | std::views::values)
+                ring->closed.store(true, std::memory_order_release);
+        }
 
-    while (true) {
-        std::expected<Record, std::error_code> record = receiver.tryReceive();
+        std::list<std::pair<std::uint64_t, std::shared_ptr<Staging>>> list;
+    };
 
-        if (!record) {
-            if (record.error() == concurrent::TryReceiveError::Disconnected)
-                break;
+    thread_local Rings rings;
+    auto &list = rings.list;
+
+    if (const auto it = std::ranges::find(list, mID, &decltype(rings.list)::value_type::first); it != list.end())
+        return *it->second;
+
+    // the rings of destroyed loggers
+    list.remove_if([](const auto &ring) {
+        return ring.second->closed.load(std::memory_order_acquire);
+    });
+
+    auto ring = std::make_shared<Staging>(StagingBufferSize);
+
+    {
+        const std::lock_guard guard{mStagingMutex};
+        mStaging.push_back(ring);
+    }
+
+    return *list.emplace_back(mID, std::move(ring)).second;
+}
+
+zero::log::Logger::Staging::Staging(const std::size_t capacity) : ring{capacity}, closed{false} {
+}
+
+bool zero::log::Logger::RateLimit::allow(const std::chrono::system_clock::time_point timestamp) {
+    if (const auto n = every.load(std::memory_order_relaxed);
+        n > 1 && seen.fetch_add(1, std::memory_order_relaxed) % n != 0)
+        return false;
+
+    const auto max = limit.load(std::memory_order_relaxed);
+
+    if (max == std::numeric_limits<std::size_t>::max())
+        return true;
+
+    const auto second = duration_cast<std::chrono::seconds>(timestamp.time_since_epoch()).count();
 
-            std::list<std::chrono::milliseconds> durations;
+    // whoever moves the window on restarts the count, a few records of the new second may still be counted against
+    // the old one
+    if (auto current = window.load(std::memory_order_relaxed);
+        current < second && window.compare_exchange_strong(current, second, std::memory_order_relaxed))
+        count.store(0, std::memory_order_relaxed);
 
-            {
-                const std::lock_guard guard{mMutex};
+    return count.fetch_add(1, std::memory_order_relaxed) < max;
+}
+
+bool zero::log::Logger::sample(const Record &record) {
+    if (!mLevelLimits[std::to_underlying(record.level)].allow(record.timestamp))
+        return false;
+
+    if (!record.tag || !mTagLimits.load(std::memory_order_relaxed))
+        return true;
+
+    return read(mTagLimits, mTagLimitMutex, TagLimitHazard, [&](const TagLimits &limits) {
+        const auto limit = limits.find(*record.tag);
+        return !limit || (*limit)->allow(record.timestamp);
+    });
+}
+
+bool zero::log::Logger::stage(Staging &staging, Entry entry) {
+    switch (mOverflowPolicy.load(std::memory_order_relaxed)) {
+    case OverflowPolicy::Block: {
+        if (staging.ring.push(std::move(entry)))
+            return true;
+
+        const auto deadline = mSendTimeout.transform([](const auto timeout) {
+            return std::chrono::steady_clock::now() + timeout;
+        });
 
-                const auto now = std::chrono::system_clock::now();
-                auto it = mConfigs.begin();
+        while (true) {
+            const auto key = staging.space.prepare();
 
-                while (it != mConfigs.end()) {
-                    const auto duration = duration_cast<std::chrono::milliseconds>(it->flushDeadline - now);
+            if (staging.ring.push(std::move(entry))) {
+                staging.space.cancel();
+                return true;
+            }
 
-                    if (duration.count() <= 0) {
-                        try {
-                            it->sink->flush();
-                        }
-                        catch (const std::exception &e) {
-                            fmt::print(stderr, "Failed to flush log: {}\n", e);
-                            it = mConfigs.erase(it);
-                            continue;
-                        }
+            std::optional<std::chrono::milliseconds> remaining;
 
-                        it++->flushDeadline = now + it->flushInterval;
-                        continue;
-                    }
+            if (deadline) {
+                remaining = std::chrono::ceil<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now());
 
-                    durations.push_back(duration);
-                    ++it;
+                if (remaining->count() <= 0) {
+                    staging.space.cancel();
+                    return false;
                 }
             }
 
-            if (durations.empty())
-                record = receiver.receive();
-            else
-                record = receiver.receive(*std::ranges::min_element(durations));
+            if (const auto result = staging.space.wait(key, remaining); !result && result.error() != std::errc::timed_out)
+                throw error::StacktraceError<std::system_error>{result.error()};
+        }
+    }
+
+    case OverflowPolicy::DropNewest:
+        return staging.ring.push(std::move(entry));
+
+    case OverflowPolicy::DropOldest:
+        if (staging.ring.pushEvicting(std::move(entry))) {
+            mOverflowed.fetch_add(1, std::memory_order_relaxed);
+            --mPending;
+        }
+
+        return true;
+    }
 
-            if (!record)
+    std::unreachable();
+}
+
+// Moves everything staged so far into `batch`, and drops the rings of threads that have exited once they are empty.
+void zero::log::Logger::drain(std::vector<Entry> &batch) {
+    const std::lock_guard guard{mStagingMutex};
+
+    // a ring is claimed while it is consumed, so room for all of them is made up front rather than by a push_back
+    // that may throw
+    batch.reserve(batch.size() + mStaging.size() * StagingBufferSize);
+
+    std::erase_if(mStaging, [&](const auto &ring) {
+        // checked first, the records a thread staged before closing its ring are all visible once this is seen
+        const auto closed = ring->closed.load(std::memory_order_acquire);
+
+        const auto count = ring->ring.consume(StagingBufferSize, [&](Entry &entry) {
+            batch.push_back(std::move(entry));
+        });
+
+        if (count == 0)
+            return closed;
+
+        ring->space.notify();
+        return false;
+    });
+}
+
+// Flushes the sinks whose deadline has passed, returns how long until the next one is due.
+std::optional<std::chrono::milliseconds> zero::log::Logger::flushExpired() {
+    std::optional<std::chrono::milliseconds> next;
+    const std::lock_guard guard{mMutex};
+
+    const auto now = std::chrono::system_clock::now();
+    auto it = mConfigs.begin();
+
+    while (it != mConfigs.end()) {
+        const auto duration = duration_cast<std::chrono::milliseconds>(it->flushDeadline - now);
+
+        if (duration.count() <= 0) {
+            try {
+                it->sink->flush();
+            }
+            catch (const std::exception &e) {
+                fmt::print(stderr, "Failed to flush log: {}\n", e);
+                it = mConfigs.erase(it);
                 continue;
+            }
+
+            it++->flushDeadline = now + it->flushInterval;
+            continue;
         }
 
-        const std::lock_guard guard{mMutex};
+        next = next ? std::min(*next, duration) : duration;
+        ++it;
+    }
 
-        const auto now = std::chrono::system_clock::now();
-        auto it = mConfigs.begin();
+    return next;
+}
 
-        while (it != mConfigs.end()) {
-            if (record->level <= std::max(it->level, mMinLogLevel.value_or(Level::Error)) &&
-                (it->tags.empty()
-                     ? !record->tag
-                     : record->tag.has_value() && std::ranges::contains(it->tags, *record->tag))) {
-                try {
-                    it->sink->write(*record);
-                }
-                catch (const std::exception &e) {
-                    fmt::print(stderr, "Failed to write log: {}\n", e);
-                    it = mConfigs.erase(it);
-                    continue;
-                }
+void zero::log::Logger::consume() {
+    std::vector<Entry> batch;
+    std::vector<Record> records;
+
+    while (true) {
+        const auto key = mEvent.prepare();
+        // read before draining, everything logged before the logger was closed is still written
+        const auto closed = mClosed.load();
+
+        drain(batch);
+
+        if (batch.empty()) {
+            if (closed) {
+                mEvent.cancel();
+                break;
             }
 
-            if (it->flushDeadline <= now) {
-                try {
-                    it->sink->flush();
-                }
-                catch (const std::exception &e) {
-                    fmt::print(stderr, "Failed to flush log: {}\n", e);
-                    it = mConfigs.erase(it);
-                    continue;
-                }
+            if (const auto result = mEvent.wait(key, flushExpired()); !result && result.error() != std::errc::timed_out)
+                throw error::StacktraceError<std::system_error>{result.error()};
+
+            continue;
+        }
+
+        mEvent.cancel();
+
+        // the rings are each in order, merging them restores the order across threads
+        std::ranges::stable_sort(batch, {}, [](const Entry &entry) {
+            return entry.record.timestamp;
+        });
+
+        dispatch(batch, records);
+
+        batch.clear();
+        records.clear();
+    }
+}
+
+// Hands each sink the records it takes as a few contiguous runs, a single one when it takes the whole batch.
+void zero::log::Logger::dispatch(const std::span<Entry> batch, std::vector<Record> &records) {
+    const std::lock_guard guard{mMutex};
+
+    const auto accepts = [this](const Config &config, const Record &record) {
+        return record.level <= std::max(config.level, mMinLogLevel.value_or(Level::Error)) &&
+            (config.tags.empty()
+                 ? !record.tag
+                 : record.tag.has_value() && std::ranges::contains(config.tags, *record.tag));
+    };
+
+    for (auto &[record, message]: batch) {
+        // formatted once, and only if a sink takes the record
+        if (!std::ranges::any_of(mConfigs, [&](const auto &config) { return accepts(config, record); }))
+            continue;
+
+        if (message)
+            record.content = message->format();
+
+        records.push_back(std::move(record));
+    }
+
+    const auto now = std::chrono::system_clock::now();
+    auto it = mConfigs.begin();
+
+    while (it != mConfigs.end()) {
+        const auto taken = [&](const auto &record) {
+            return accepts(*it, record);
+        };
+
+        try {
+            auto first = std::ranges::find_if(records, taken);
+
+            while (first != records.end()) {
+                const auto last = std::find_if_not(first, records.end(), taken);
+                it->sink->writeBatch(std::span<const Record>{first, last});
+                first = std::find_if(last, records.end(), taken);
+            }
+        }
+        catch (const std::exception &e) {
+            fmt::print(stderr, "Failed to write log: {}\n", e);
+            it = mConfigs.erase(it);
+            continue;
+        }
 
-                it++->flushDeadline = now + it->flushInterval;
+        if (it->flushDeadline <= now) {
+            try {
+                it->sink->flush();
+            }
+            catch (const std::exception &e) {
+                fmt::print(stderr, "Failed to flush log: {}\n", e);
+                it = mConfigs.erase(it);
                 continue;
             }
 
-            ++it;
+            it++->flushDeadline = now + it->flushInterval;
+            continue;
         }
 
-        if (--mPending == 0)
-            mPending.notify_all();
+        ++it;
     }
+
+    if (mPending.fetch_sub(batch.size()) == batch.size())
+        mPending.notify_all();
 }
 
-void zero::log::Logger::refreshMaxLogLevel() {
+template<typename V>
+zero::log::Logger::TagTable<V>::TagTable(const std::map<std::string_view, V> &entries)
+    : slots(entries.empty() ? 0 : std::bit_ceil(entries.size() * 2)), size{entries.size()} {
+    const auto mask = slots.size() - 1;
+
+    for (const auto &[tag, value]: entries) {
+        auto index = std::hash<std::string_view>{}(tag) & mask;
+
+        while (slots[index])
+            index = (index + 1) & mask;
+
+        slots[index].emplace(tag, value);
+    }
+}
+
+template<typename V>
+const V *zero::log::Logger::TagTable<V>::find(const std::string_view tag) const {
+    if (slots.empty())
+        return nullptr;
+
+    const auto mask = slots.size() - 1;
+
+    for (auto index = std::hash<std::string_view>{}(tag) & mask; slots[index]; index = (index + 1) & mask) {
+        if (slots[index]->first == tag)
+            return &slots[index]->second;
+    }
+
+    return nullptr;
+}
+
+// Called with `mMutex` held whenever the sinks change.
+void zero::log::Logger::refreshLevels() {
+    std::map<std::string_view, Level> levels;
+
+    for (const auto &config: mConfigs) {
+        const auto level = std::max(config.level, mMinLogLevel.value_or(Level::Error));
+
+        for (const auto &tag: config.tags) {
+            if (const auto [it, inserted] = levels.try_emplace(tag, level); !inserted)
+                it->second = std::max(it->second, level);
+        }
+    }
+
+    // most changes to the sinks leave the levels of every tag as they were
+    if (const auto current = mTagLevels.load(std::memory_order_relaxed);
+        !current || current->size != levels.size() || !std::ranges::all_of(levels, [&](const auto &entry) {
+            const auto level = current->find(entry.first);
+            return level && *level == entry.second;
+        }))
+        publish(mTagLevels, mTagLevelSnapshots, std::make_unique<const TagLevels>(levels));
+
     if (mConfigs.empty()) {
         mMaxLogLevel = NoSinkSentinel;
         return;
@@ -223,17 +674,11 @@ bool zero::log::Logger::enabled(const Level level, const std::string_view tag) c
     if (!enabled(level))
         return false;
 
-    const std::lock_guard guard{mMutex};
-
-    return std::ranges::any_of(
-        mConfigs,
-        [&](const auto &config) {
-            if (mMinLogLevel)
-                return std::max(config.level, *mMinLogLevel) >= level && std::ranges::contains(config.tags, tag);
-
-            return config.level >= level && std::ranges::contains(config.tags, tag);
-        }
-    );
+    // published before the maximum level, so a sink seen by the check above is in it
+    return read(mTagLevels, mMutex, TagLevelHazard, [&](const TagLevels &levels) {
+        const auto max = levels.find(tag);
+        return max && level <= *max;
+    });
 }
 
 void zero::log::Logger::add(
@@ -298,7 +743,7 @@ void zero::log::Logger::add(
         std::chrono::system_clock::now() + interval
     );
 
-    refreshMaxLogLevel();
+    refreshLevels();
 }
 
 void zero::log::Logger::remove(const std::string_view name) {
@@ -309,7 +754,7 @@ void zero::log::Logger::remove(const std::string_view name) {
     }) == 0)
         throw std::runtime_error{fmt::format("Sink '{}' not found", name)};
 
-    refreshMaxLogLevel();
+    refreshLevels();
 }
 
 void zero::log::Logger::setLevel(const std::string_view name, const Level level) {
@@ -325,7 +770,7 @@ void zero::log::Logger::setLevel(const std::string_view name, const Level level)
         throw std::runtime_error{fmt::format("Sink '{}' not found", name)};
 
     it->level = level;
-    refreshMaxLogLevel();
+    refreshLevels();
 }
 
 void zero::log::Logger::setFlushInterval(const std::string_view name, const std::chrono::milliseconds interval) {
@@ -344,6 +789,59 @@ void zero::log::Logger::setFlushInterval(const std::string_view name, const std:
     it->flushDeadline = std::chrono::system_clock::now() + interval;
 }
 
+void zero::log::Logger::setOverflowPolicy(const OverflowPolicy policy) {
+    mOverflowPolicy.store(policy, std::memory_order_relaxed);
+}
+
+void zero::log::Logger::setRateLimit(const Level level, const std::optional<std::size_t> perSecond) {
+    mLevelLimits[std::to_underlying(level)].limit = perSecond.value_or(std::numeric_limits<std::size_t>::max());
+}
+
+void zero::log::Logger::setRateLimit(const std::string_view tag, const std::optional<std::size_t> perSecond) {
+    setTagLimit(tag, &RateLimit::limit, perSecond.value_or(std::numeric_limits<std::size_t>::max()));
+}
+
+void zero::log::Logger::setSampleRate(const Level level, const std::optional<std::size_t> n) {
+    mLevelLimits[std::to_underlying(level)].every = std::max(n.value_or(1), 1uz);
+}
+
+void zero::log::Logger::setSampleRate(const std::string_view tag, const std::optional<std::size_t> n) {
+    setTagLimit(tag, &RateLimit::every, std::max(n.value_or(1), 1uz));
+}
+
+// The limits of a tag that has some are changed in place, a new tag publishes a snapshot carrying the others over.
+void zero::log::Logger::setTagLimit(
+    const std::string_view tag,
+    std::atomic<std::size_t> RateLimit::*field,
+    const std::size_t value
+) {
+    const std::lock_guard guard{mTagLimitMutex};
+    const auto current = mTagLimits.load(std::memory_order_relaxed);
+
+    if (const auto limit = current ? current->find(tag) : nullptr) {
+        (**limit).*field = value;
+        return;
+    }
+
+    std::map<std::string_view, std::shared_ptr<RateLimit>> limits;
+
+    if (current) {
+        for (const auto &slot: current->slots) {
+            if (slot)
+                limits.emplace(slot->first, slot->second);
+        }
+    }
+
+    const auto limit = limits.emplace(tag, std::make_shared<RateLimit>()).first->second;
+    (*limit).*field = value;
+
+    publish(mTagLimits, mTagLimitSnapshots, std::make_unique<const TagLimits>(limits));
+}
+
+zero::log::DropCounts zero::log::Logger::dropped() const {
+    return {mOverflowed.load(std::memory_order_relaxed), mSampled.load(std::memory_order_relaxed)};
+}
+
 void zero::log::Logger::log(
     const Level level,
     const std::string_view filename,
@@ -351,7 +849,7 @@ void zero::log::Logger::log(
     std::string content,
     const std::optional<std::string_view> &tag
 ) {
-    if (const auto result = mChannel.first.send(
+    enqueue({
         {
             .level = level,
             .line = line,
@@ -360,13 +858,50 @@ void zero::log::Logger::log(
             .content = std::move(content),
             .tag = tag
         },
-        mSendTimeout
-    ); !result) {
-        fmt::print(stderr, "Failed to send log: {}\n", std::error_code{result.error()});
+        std::nullopt
+    });
+}
+
+void zero::log::Logger::log(
+    const Level level,
+    const std::string_view filename,
+    const int line,
+    DeferredMessage message,
+    const std::optional<std::string_view> &tag
+) {
+    enqueue({
+        {
+            .level = level,
+            .line = line,
+            .filename = filename,
+            .timestamp = std::chrono::system_clock::now(),
+            .tag = tag
+        },
+        message
+    });
+}
+
+void zero::log::Logger::enqueue(Entry entry) {
+    if (!sample(entry.record)) {
+        mSampled.fetch_add(1, std::memory_order_relaxed);
         return;
     }
 
+    auto &ring = staging();
+
+    // counted first, so that the logger thread cannot get to the record before it is
     ++mPending;
+
+    if (!stage(ring, std::move(entry))) {
+        mOverflowed.fetch_add(1, std::memory_order_relaxed);
+
+        if (--mPending == 0)
+            mPending.notify_all();
+
+        return;
+    }
+
+    mEvent.notify();
 }
 
 void zero::log::Logger::sync() const {
@@ -0,0 +1,111 @@
+#include <catch_extensions.h>
+#include <zero/async/cancellation.h>
+#include <thread>
+
+TEST_CASE("cancellation", "[async::cancellation]") {
+    SECTION("empty token") {
+        const zero::async::CancellationToken token;
+        REQUIRE_FALSE(token.cancellable());
+        REQUIRE_FALSE(token.cancelled());
+
+        auto called = false;
+        const auto subscription = token.subscribe([&] {
+            called = true;
+        });
+
+        REQUIRE_FALSE(called);
+    }
+
+    SECTION("cancel") {
+        zero::async::CancellationSource source;
+        const auto token = source.token();
+        REQUIRE(token.cancellable());
+        REQUIRE_FALSE(token.cancelled());
+
+        int count{0};
+
+        const auto subscription1 = token.subscribe([&] {
+            ++count;
+        });
+
+        const auto subscription2 = token.subscribe([&] {
+            ++count;
+        });
+
+        REQUIRE(source.cancel());
+        REQUIRE_FALSE(source.cancel());
+        REQUIRE(source.cancelled());
+        REQUIRE(token.cancelled());
+        REQUIRE(count == 2);
+    }
+
+    SECTION("subscribe after cancellation") {
+        zero::async::CancellationSource source;
+        source.cancel();
+
+        auto called = false;
+        const auto subscription = source.token().subscribe([&] {
+            called = true;
+        });
+
+        REQUIRE(called);
+    }
+
+    SECTION("unsubscribe") {
+        zero::async::CancellationSource source;
+        auto called = false;
+
+        auto subscription = source.token().subscribe([&] {
+            called = true;
+        });
+
+        subscription.reset();
+        source.cancel();
+        REQUIRE_FALSE(called);
+    }
+
+    SECTION("child") {
+        zero::async::CancellationSource parent;
+        zero::async::CancellationSource child{parent.token()};
+
+        SECTION("cancel child") {
+            REQUIRE(child.cancel());
+            REQUIRE_FALSE(parent.cancelled());
+        }
+
+        SECTION("cancel parent") {
+            REQUIRE(parent.cancel());
+            REQUIRE(child.cancelled());
+        }
+
+        SECTION("cancelled parent") {
+            const zero::async::CancellationSource source{parent.token()};
+            REQUIRE_FALSE(source.cancelled());
+
+            parent.cancel();
+            REQUIRE(source.cancelled());
+            REQUIRE(zero::async::CancellationSource{parent.token()}.cancelled());
+        }
+    }
+
+    SECTION("concurrent") {
+        zero::async::CancellationSource source;
+        std::atomic<int> count;
+        std::vector<zero::async::CancellationSubscription> subscriptions;
+
+        std::thread thread{
+            [&] {
+                source.cancel();
+            }
+        };
+
+        for (int i{0}; i < 1000; ++i) {
+            subscriptions.push_back(source.token().subscribe([&] {
+                ++count;
+            }));
+        }
+
+        thread.join();
+        REQUIRE(count == 1000);
+    }
+}
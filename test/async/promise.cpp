@@ -1,5 +1,6 @@
 #include <catch_extensions.h>
 #include <zero/async/promise.h>
+#include <zero/expect.h>
 #include <zero/concurrent/channel.h>
 #include <thread>
 #include <list>
@@ -145,9 +146,64 @@ TEST_CASE("promise and future", "[async::promise]") {
             REQUIRE(future.wait());
             REQUIRE_ERROR(future.result(), std::errc::invalid_argument);
         }
+
+        SECTION("wait") {
+            std::thread thread{
+                [&] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+                    promise.resolve(1);
+                }
+            };
+
+            REQUIRE(future.wait());
+            REQUIRE(future.result() == 1);
+            thread.join();
+        }
+
+        SECTION("wait timeout") {
+            REQUIRE_ERROR(future.wait(std::chrono::milliseconds{10}), std::errc::timed_out);
+
+            auto next = std::move(future)
+                        .via(zero::async::promise::InlineExecutor::instance())
+                        .then([](const int value) {
+                            return value * 2;
+                        });
+
+            promise.resolve(1);
+            REQUIRE(next.isReady());
+            REQUIRE(next.result() == 2);
+        }
     }
 }
 
+TEST_CASE("wait for a future with a callback", "[async::promise]") {
+    zero::async::promise::Promise<int, std::error_code> promise;
+    auto future = promise.getFuture().via(zero::async::promise::InlineExecutor::instance());
+
+    std::expected<void, std::error_code> waited;
+
+    std::thread thread{
+        [&] {
+            waited = future.wait(std::chrono::seconds{10});
+        }
+    };
+
+    // let the waiter block first, so that attaching the callback replaces its state
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+    int value{0};
+
+    future.setCallback([&](const std::expected<int, std::error_code> result) {
+        value = *result;
+    });
+
+    promise.resolve(1);
+    thread.join();
+
+    REQUIRE(waited);
+    REQUIRE(value == 1);
+}
+
 TEST_CASE("create a resolved future", "[async::promise]") {
     SECTION("void") {
         const auto future = zero::async::promise::Future<void, std::error_code>::resolved();
@@ -206,6 +262,40 @@ TEST_CASE("receive future value and transform", "[async::promise]") {
     }
 }
 
+TEST_CASE("receive future value with move-only callback", "[async::promise]") {
+    const auto result = zero::async::promise::Future<int, std::error_code>::resolved(1)
+                        .then([ptr = std::make_unique<int>(2)](const auto &value) {
+                            return value * *ptr;
+                        })
+                        .get();
+    REQUIRE(result == 2);
+}
+
+TEST_CASE("custom executor without move-only post", "[async::promise]") {
+    class Executor final : public zero::async::promise::IExecutor {
+    public:
+        using IExecutor::post;
+
+        void post(const std::function<void()> f) override {
+            ++count;
+            f();
+        }
+
+        int count{};
+    };
+
+    const auto executor = std::make_shared<Executor>();
+    auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+
+    auto next = std::move(future).then([ptr = std::make_unique<int>(2)](const auto &value) {
+        return value * *ptr;
+    });
+
+    promise.resolve(1);
+    REQUIRE(std::move(next).get() == 2);
+    REQUIRE(executor->count == 1);
+}
+
 TEST_CASE("receive future value and try to do something", "[async::promise]") {
     SECTION("void") {
         SECTION("success") {
@@ -1167,3 +1257,634 @@ TEST_CASE("promise variadic race concurrency testing", "[async::promise]") {
     }
 }
 #endif
+
+TEST_CASE("thread pool executor", "[async::promise]") {
+    const auto executor = std::make_shared<zero::async::promise::ThreadPoolExecutor>(ThreadNumber);
+    REQUIRE(executor->concurrency() == ThreadNumber);
+
+    SECTION("continuation") {
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+
+        auto next = std::move(future).then([](const int value) {
+            return std::pair{value * 2, std::this_thread::get_id()};
+        });
+
+        promise.resolve(1);
+
+        const auto result = std::move(next).get();
+        REQUIRE(result);
+        REQUIRE(result->first == 2);
+        REQUIRE(result->second != std::this_thread::get_id());
+    }
+
+    SECTION("fan out") {
+        constexpr auto N = 10000;
+
+        std::vector<zero::async::promise::Future<int, std::error_code>> futures;
+        std::vector<zero::async::promise::Promise<int, std::error_code>> promises;
+
+        for (int i{0}; i < N; ++i) {
+            auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+
+            futures.push_back(std::move(future).then([](const int value) {
+                return value + 1;
+            }));
+
+            promises.push_back(std::move(promise));
+        }
+
+        for (int i{0}; i < N; ++i)
+            promises[i].resolve(i);
+
+        const auto result = all(std::move(futures)).get();
+        REQUIRE(result);
+        REQUIRE(result->size() == N);
+        REQUIRE(result->front() == 1);
+        REQUIRE(result->back() == N);
+    }
+
+    SECTION("nested post") {
+        constexpr auto N = 1000;
+
+        std::atomic<int> count;
+        zero::atomic::Event event;
+
+        for (int i{0}; i < N; ++i) {
+            executor->post([&] {
+                executor->post([&] {
+                    if (++count == N)
+                        event.set();
+                });
+            });
+        }
+
+        REQUIRE(event.wait());
+        REQUIRE(count == N);
+    }
+}
+
+namespace {
+    zero::async::promise::Task<int, std::error_code> twice(zero::async::promise::Future<int, std::error_code> future) {
+        const auto value = co_await std::move(future);
+        Z_CO_EXPECT(value);
+        co_return *value * 2;
+    }
+
+    zero::async::promise::Task<int> sum(std::vector<zero::async::promise::Future<int>> futures) {
+        int result{0};
+
+        for (auto &future: futures)
+            result += co_await std::move(future);
+
+        co_return result;
+    }
+
+    zero::async::promise::Task<void> fail() {
+        throw std::runtime_error{"error"};
+        co_return;
+    }
+
+    zero::async::promise::Task<int, std::error_code> raise(std::exception_ptr exception) {
+        std::rethrow_exception(std::move(exception));
+        co_return 0;
+    }
+}
+
+TEST_CASE("promise coroutine", "[async::promise]") {
+    SECTION("ready") {
+        const auto result = twice(zero::async::promise::Future<int, std::error_code>::resolved(1)).get();
+        REQUIRE(result == 2);
+    }
+
+    SECTION("error") {
+        const auto result = twice(
+            zero::async::promise::Future<int, std::error_code>::rejected(make_error_code(std::errc::invalid_argument))
+        ).get();
+        REQUIRE_ERROR(result, std::errc::invalid_argument);
+    }
+
+    SECTION("suspend") {
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(
+            zero::async::promise::InlineExecutor::instance()
+        );
+
+        auto task = twice(std::move(future));
+        REQUIRE_FALSE(task.isReady());
+
+        promise.resolve(2);
+        REQUIRE(task.isReady());
+        REQUIRE(std::move(task).get() == 4);
+    }
+
+    SECTION("semi future") {
+        zero::async::promise::Promise<int, std::error_code> promise;
+
+        auto task = [](zero::async::promise::SemiFuture<int, std::error_code> future)
+            -> zero::async::promise::Task<int, std::error_code> {
+            co_return co_await std::move(future);
+        }(promise.getFuture());
+
+        promise.resolve(1);
+        REQUIRE(std::move(task).get() == 1);
+    }
+
+    SECTION("exception") {
+        std::vector<zero::async::promise::Future<int>> futures;
+        futures.push_back(zero::async::promise::Future<int>::resolved(1));
+        futures.push_back(zero::async::promise::Future<int>::resolved(2));
+
+        REQUIRE(sum(std::move(futures)).get() == 3);
+        REQUIRE_THROWS_AS(fail().get(), std::runtime_error);
+    }
+
+    SECTION("exception with error code") {
+        REQUIRE_ERROR(
+            raise(std::make_exception_ptr(std::system_error{make_error_code(std::errc::invalid_argument)})).get(),
+            std::errc::invalid_argument
+        );
+        REQUIRE_ERROR(
+            raise(std::make_exception_ptr(std::runtime_error{"error"})).get(),
+            zero::async::promise::TaskError::UnhandledException
+        );
+
+        const auto executor = std::make_shared<zero::async::promise::ThreadPoolExecutor>(ThreadNumber);
+        auto [promise, future] = zero::async::promise::contract<void, std::error_code>(executor);
+
+        auto task = [](zero::async::promise::Future<void, std::error_code> f)
+            -> zero::async::promise::Task<int, std::error_code> {
+            Z_CO_EXPECT(co_await std::move(f));
+            throw std::runtime_error{"error"};
+        }(std::move(future));
+
+        promise.resolve();
+        REQUIRE_ERROR(std::move(task).get(), zero::async::promise::TaskError::UnhandledException);
+    }
+
+    SECTION("chain") {
+        const auto result = twice(twice(resolved<int, std::error_code>(1)).via())
+                            .via()
+                            .then([](const int value) {
+                                return value + 1;
+                            })
+                            .get();
+        REQUIRE(result == 5);
+    }
+
+    SECTION("thread pool") {
+        const auto executor = std::make_shared<zero::async::promise::ThreadPoolExecutor>(ThreadNumber);
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+
+        auto task = twice(std::move(future));
+        promise.resolve(3);
+        REQUIRE(std::move(task).get() == 6);
+    }
+}
+
+namespace {
+    struct Pooled {
+        int value;
+    };
+}
+
+TEST_CASE("promise core pool", "[async::promise]") {
+    using Pool = zero::async::promise::CorePool<Pooled, std::error_code>;
+
+    const auto [hits, misses] = Pool::statistics();
+
+    SECTION("reuse") {
+        {
+            zero::async::promise::Promise<Pooled, std::error_code> promise;
+            promise.resolve(Pooled{1});
+            REQUIRE(promise.getFuture().get()->value == 1);
+        }
+
+        REQUIRE(Pool::statistics().misses == misses + 1);
+        REQUIRE(Pool::statistics().hits == hits);
+
+        {
+            zero::async::promise::Promise<Pooled, std::error_code> promise;
+            promise.resolve(Pooled{2});
+            REQUIRE(promise.getFuture().get()->value == 2);
+        }
+
+        REQUIRE(Pool::statistics().misses == misses + 1);
+        REQUIRE(Pool::statistics().hits == hits + 1);
+    }
+
+    SECTION("cross thread") {
+        auto [promise, future] = zero::async::promise::contract<Pooled, std::error_code>(
+            zero::async::promise::InlineExecutor::instance()
+        );
+
+        std::thread thread{
+            [promise = std::move(promise)]() mutable {
+                promise.resolve(Pooled{3});
+            }
+        };
+
+        const auto result = std::move(future)
+                            .then([](const Pooled pooled) {
+                                return Pooled{pooled.value * 2};
+                            })
+                            .get();
+
+        thread.join();
+
+        REQUIRE(result);
+        REQUIRE(result->value == 6);
+
+        const auto statistics = Pool::statistics();
+        REQUIRE(statistics.hits + statistics.misses == hits + misses + 2);
+    }
+}
+
+TEST_CASE("promise timer", "[async::promise]") {
+    SECTION("sleep") {
+        const auto start = std::chrono::steady_clock::now();
+        REQUIRE(zero::async::promise::sleep<std::error_code>(std::chrono::milliseconds{20}).get());
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds{20});
+    }
+
+    SECTION("timeout") {
+        SECTION("error code") {
+            auto [promise, future] = zero::async::promise::contract<int, std::error_code>(
+                zero::async::promise::InlineExecutor::instance()
+            );
+
+            const auto result = std::move(future).timeout(std::chrono::milliseconds{10}).get();
+            REQUIRE_ERROR(result, zero::async::promise::TimeoutError::Elapsed);
+            REQUIRE(result.error() == std::errc::timed_out);
+        }
+
+        SECTION("exception") {
+            auto [promise, future] = zero::async::promise::contract<int>(
+                zero::async::promise::InlineExecutor::instance()
+            );
+
+            REQUIRE_THROWS_AS(std::move(future).timeout(std::chrono::milliseconds{10}).get(), std::system_error);
+        }
+
+        SECTION("settled in time") {
+            const auto wheel = std::make_shared<zero::async::TimerWheel>();
+
+            auto future = zero::async::promise::sleep<std::error_code>(std::chrono::milliseconds{10})
+                          .via()
+                          .then([] {
+                              return 1;
+                          })
+                          .timeout(std::chrono::seconds{10}, wheel);
+
+            REQUIRE(std::move(future).get() == 1);
+            REQUIRE(wheel->size() == 0);
+        }
+    }
+}
+
+TEST_CASE("promise cancellation", "[async::promise]") {
+    const auto executor = zero::async::promise::InlineExecutor::instance();
+
+    SECTION("not cancellable") {
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor);
+        REQUIRE_FALSE(promise.token().cancellable());
+        REQUIRE_FALSE(future.cancellation());
+        REQUIRE_FALSE(future.cancel());
+    }
+
+    SECTION("token") {
+        zero::async::CancellationSource source;
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+        REQUIRE(promise.token().cancellable());
+        REQUIRE_FALSE(promise.isCancelled());
+
+        const auto subscription = promise.token().subscribe([&promise] {
+            promise.reject(std::make_error_code(std::errc::operation_canceled));
+        });
+
+        source.cancel();
+        REQUIRE(promise.isCancelled());
+        REQUIRE_ERROR(std::move(future).get(), std::errc::operation_canceled);
+    }
+
+    SECTION("chain") {
+        zero::async::CancellationSource source;
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        auto next = std::move(future)
+                    .then([](const int value) {
+                        return value * 2;
+                    })
+                    .fail([](const std::error_code &ec) -> std::expected<int, std::error_code> {
+                        return std::unexpected{ec};
+                    });
+
+        REQUIRE(next.cancel());
+        REQUIRE(promise.isCancelled());
+        REQUIRE_FALSE(source.cancelled());
+    }
+
+    SECTION("race") {
+        zero::async::CancellationSource source;
+        auto [promise1, future1] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+        auto [promise2, future2] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        auto result = race(std::move(future1), std::move(future2));
+        REQUIRE_FALSE(promise1.isCancelled());
+        REQUIRE_FALSE(promise2.isCancelled());
+
+        promise1.resolve(1);
+        REQUIRE(promise2.isCancelled());
+        REQUIRE(std::move(result).get() == 1);
+        REQUIRE_FALSE(source.cancelled());
+    }
+
+    SECTION("race already decided") {
+        zero::async::CancellationSource source;
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        auto result = race(
+            zero::async::promise::Future<int, std::error_code>::resolved(1),
+            std::move(future)
+        );
+
+        REQUIRE(promise.isCancelled());
+        REQUIRE(std::move(result).get() == 1);
+    }
+
+    SECTION("all") {
+        zero::async::CancellationSource source;
+        auto [promise1, future1] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+        auto [promise2, future2] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        std::vector<zero::async::promise::Future<int, std::error_code>> futures;
+        futures.push_back(std::move(future1));
+        futures.push_back(std::move(future2));
+
+        auto result = all(std::move(futures));
+
+        promise1.reject(std::make_error_code(std::errc::invalid_argument));
+        REQUIRE(promise2.isCancelled());
+        REQUIRE_ERROR(std::move(result).get(), std::errc::invalid_argument);
+    }
+
+    SECTION("any") {
+        zero::async::CancellationSource source;
+        auto [promise1, future1] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+        auto [promise2, future2] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        auto result = any(std::move(future1), std::move(future2));
+
+        promise1.reject(std::make_error_code(std::errc::invalid_argument));
+        REQUIRE_FALSE(promise2.isCancelled());
+
+        promise2.resolve(2);
+        REQUIRE(std::move(result).get() == 2);
+    }
+
+    SECTION("cancel aggregate") {
+        zero::async::CancellationSource source;
+        auto [promise1, future1] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+        auto [promise2, future2] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        auto result = race(std::move(future1), std::move(future2));
+        REQUIRE(result.cancel());
+        REQUIRE(promise1.isCancelled());
+        REQUIRE(promise2.isCancelled());
+    }
+
+    SECTION("timeout") {
+        zero::async::CancellationSource source;
+        auto [promise, future] = zero::async::promise::contract<int, std::error_code>(executor, source.token());
+
+        const auto result = std::move(future).timeout(std::chrono::milliseconds{10}).get();
+        REQUIRE_ERROR(result, zero::async::promise::TimeoutError::Elapsed);
+        REQUIRE(promise.isCancelled());
+    }
+}
+
+namespace {
+    struct NonDefault {
+        explicit NonDefault(const int v) : value{v} {
+        }
+
+        int value;
+    };
+}
+
+TEST_CASE("promise gather", "[async::promise]") {
+    const auto executor = zero::async::promise::InlineExecutor::instance();
+
+    SECTION("resolve") {
+        std::vector<zero::async::promise::Promise<NonDefault, std::error_code>> promises(3);
+        std::vector<zero::async::promise::Future<NonDefault, std::error_code>> futures;
+
+        for (auto &promise: promises)
+            futures.push_back(promise.getFuture().via(executor));
+
+        auto future = gather(std::move(futures));
+
+        promises[2].resolve(NonDefault{3});
+        promises[0].resolve(NonDefault{1});
+        REQUIRE_FALSE(future.isReady());
+
+        promises[1].resolve(NonDefault{2});
+        REQUIRE(future.isReady());
+
+        const auto result = std::move(future).get();
+        REQUIRE(result);
+        REQUIRE(result->size() == 3);
+        REQUIRE(std::ranges::equal(*result | std::views::transform(&NonDefault::value), std::array{1, 2, 3}));
+    }
+
+    SECTION("reject") {
+        std::vector<zero::async::promise::Promise<std::string, std::error_code>> promises(3);
+        std::vector<zero::async::promise::Future<std::string, std::error_code>> futures;
+
+        for (auto &promise: promises)
+            futures.push_back(promise.getFuture().via(executor));
+
+        auto future = gather(std::move(futures));
+
+        promises[0].resolve("hello");
+        promises[1].reject(make_error_code(std::errc::invalid_argument));
+        promises[2].resolve("world");
+
+        REQUIRE_ERROR(std::move(future).get(), std::errc::invalid_argument);
+    }
+}
+
+TEST_CASE("promise each", "[async::promise]") {
+    const auto executor = zero::async::promise::InlineExecutor::instance();
+
+    std::vector<zero::async::promise::Promise<int, std::error_code>> promises(3);
+    std::vector<zero::async::promise::Future<int, std::error_code>> futures;
+
+    for (auto &promise: promises)
+        futures.push_back(promise.getFuture().via(executor));
+
+    std::vector<std::pair<std::size_t, int>> results;
+
+    auto future = each(std::move(futures), [&](const std::size_t index, const int value) {
+        results.emplace_back(index, value);
+    });
+
+    SECTION("resolve") {
+        promises[1].resolve(2);
+        promises[2].resolve(3);
+        REQUIRE(results == std::vector<std::pair<std::size_t, int>>{{1, 2}, {2, 3}});
+        REQUIRE_FALSE(future.isReady());
+
+        promises[0].resolve(1);
+        REQUIRE(results.size() == 3);
+        REQUIRE(results.back() == std::pair<std::size_t, int>{0, 1});
+        REQUIRE(std::move(future).get());
+    }
+
+    SECTION("reject") {
+        promises[0].resolve(1);
+        promises[1].reject(make_error_code(std::errc::invalid_argument));
+        promises[2].resolve(3);
+
+        REQUIRE(results == std::vector<std::pair<std::size_t, int>>{{0, 1}});
+        REQUIRE_ERROR(std::move(future).get(), std::errc::invalid_argument);
+    }
+}
+
+TEST_CASE("promise map concurrent", "[async::promise]") {
+    const auto executor = zero::async::promise::InlineExecutor::instance();
+
+    SECTION("limit") {
+        std::vector<zero::async::promise::Promise<int, std::error_code>> promises;
+        std::size_t started{0};
+
+        auto future = zero::async::promise::mapConcurrent(
+            std::vector{1, 2, 3, 4, 5},
+            2,
+            [&](const int value) {
+                REQUIRE(value == static_cast<int>(++started));
+                return promises.emplace_back().getFuture().via(executor);
+            }
+        );
+
+        REQUIRE(started == 2);
+
+        promises[1].resolve(20);
+        REQUIRE(started == 3);
+
+        promises[0].resolve(10);
+        REQUIRE(started == 4);
+        REQUIRE_FALSE(future.isReady());
+
+        promises[3].resolve(40);
+        promises[4].resolve(50);
+        REQUIRE_FALSE(future.isReady());
+
+        promises[2].resolve(30);
+        REQUIRE(std::move(future).get() == std::vector{10, 20, 30, 40, 50});
+    }
+
+    SECTION("ready") {
+        auto future = zero::async::promise::mapConcurrent(
+            std::views::iota(0, 100000),
+            4,
+            [](const int value) {
+                return zero::async::promise::Future<int, std::error_code>::resolved(value * 2);
+            }
+        );
+
+        const auto result = std::move(future).get();
+        REQUIRE(result);
+        REQUIRE(result->size() == 100000);
+        REQUIRE(result->back() == 199998);
+    }
+
+    SECTION("void") {
+        std::vector<int> values;
+
+        auto future = zero::async::promise::mapConcurrent(
+            std::vector{1, 2, 3},
+            8,
+            [&](const int value) {
+                values.push_back(value);
+                return zero::async::promise::Future<void, std::error_code>::resolved();
+            }
+        );
+
+        REQUIRE(std::move(future).get());
+        REQUIRE(values == std::vector{1, 2, 3});
+    }
+
+    SECTION("reject") {
+        std::vector<zero::async::promise::Promise<int, std::error_code>> promises;
+
+        auto future = zero::async::promise::mapConcurrent(
+            std::vector{1, 2, 3, 4},
+            2,
+            [&](int) {
+                return promises.emplace_back().getFuture().via(executor);
+            }
+        );
+
+        promises[0].reject(make_error_code(std::errc::invalid_argument));
+        REQUIRE(promises.size() == 2);
+        REQUIRE_ERROR(std::move(future).get(), std::errc::invalid_argument);
+    }
+
+    SECTION("thread pool") {
+        const auto pool = std::make_shared<zero::async::promise::ThreadPoolExecutor>(ThreadNumber);
+        std::atomic<int> running{0};
+        std::atomic<int> peak{0};
+
+        auto future = zero::async::promise::mapConcurrent(
+            std::views::iota(0, 1000),
+            3,
+            [&](const int value) {
+                auto [promise, f] = zero::async::promise::contract<int, std::error_code>(pool);
+                const auto current = ++running;
+                auto previous = peak.load();
+
+                while (previous < current && !peak.compare_exchange_weak(previous, current)) {
+                }
+
+                pool->post([&, value, p = std::move(promise)]() mutable {
+                    --running;
+                    p.resolve(value);
+                });
+
+                return std::move(f);
+            }
+        );
+
+        const auto result = std::move(future).get();
+        REQUIRE(result);
+        REQUIRE(result->size() == 1000);
+        REQUIRE(std::ranges::equal(*result, std::views::iota(0, 1000)));
+        REQUIRE(peak <= 3);
+    }
+
+    SECTION("empty") {
+        auto future = zero::async::promise::mapConcurrent(
+            std::vector<int>{},
+            2,
+            [](const int value) {
+                return zero::async::promise::Future<int, std::error_code>::resolved(value);
+            }
+        );
+
+        const auto result = std::move(future).get();
+        REQUIRE(result);
+        REQUIRE(result->empty());
+    }
+
+    SECTION("invalid limit") {
+        REQUIRE_THROWS_AS(
+            zero::async::promise::mapConcurrent(
+                std::vector{1},
+                0,
+                [](const int value) {
+                    return zero::async::promise::Future<int>::resolved(value);
+                }
+            ),
+            std::invalid_argument
+        );
+    }
+}
@@ -0,0 +1,82 @@
+#include <catch_extensions.h>
+#include <zero/async/timer.h>
+#include <future>
+#include <vector>
+
+TEST_CASE("timer wheel", "[async::timer]") {
+    zero::async::TimerWheel wheel;
+    REQUIRE(wheel.size() == 0);
+    REQUIRE(wheel.tick() == std::chrono::milliseconds{1});
+
+    SECTION("expire") {
+        std::promise<void> promise;
+        const auto start = std::chrono::steady_clock::now();
+
+        wheel.add(std::chrono::milliseconds{20}, [&] {
+            promise.set_value();
+        });
+
+        REQUIRE(wheel.size() == 1);
+
+        promise.get_future().wait();
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds{20});
+        REQUIRE(wheel.size() == 0);
+    }
+
+    SECTION("order") {
+        std::mutex mutex;
+        std::vector<int> order;
+        std::promise<void> promise;
+
+        // 70ms and 150ms land on the second level and have to be cascaded before they expire
+        for (const auto &[delay, value]: {std::pair{150, 3}, std::pair{5, 1}, std::pair{70, 2}}) {
+            wheel.add(std::chrono::milliseconds{delay}, [&, value = value] {
+                std::lock_guard guard{mutex};
+                order.push_back(value);
+
+                if (order.size() == 3)
+                    promise.set_value();
+            });
+        }
+
+        promise.get_future().wait();
+        REQUIRE(order == std::vector{1, 2, 3});
+    }
+
+    SECTION("cancel") {
+        std::atomic<bool> fired;
+        std::promise<void> promise;
+
+        const auto id = wheel.add(std::chrono::milliseconds{10}, [&] {
+            fired = true;
+        });
+
+        wheel.add(std::chrono::milliseconds{30}, [&] {
+            promise.set_value();
+        });
+
+        REQUIRE(wheel.cancel(id));
+        REQUIRE_FALSE(wheel.cancel(id));
+        REQUIRE(wheel.size() == 1);
+
+        promise.get_future().wait();
+        REQUIRE_FALSE(fired);
+    }
+
+    SECTION("many") {
+        constexpr auto N = 10000;
+
+        std::atomic<int> count;
+        std::promise<void> promise;
+
+        for (int i{0}; i < N; ++i) {
+            wheel.add(std::chrono::milliseconds{i % 100}, [&] {
+                if (++count == N)
+                    promise.set_value();
+            });
+        }
+
+        promise.get_future().wait();
+        REQUIRE(count == N);
+    }
+}
@@ -1,9 +1,31 @@
 #include <catch_extensions.h>
 #include <zero/atomic/circular_buffer.h>
 #include <zero/error.h>
+#include <thread>
+#include <ranges>
+#include <list>
+
+template<typename B>
+concept DefaultCommittable = requires(B buffer) {
+    buffer.commit(0uz);
+};
+
+namespace {
+    struct Fragile {
+        explicit Fragile(const int v) : value{v} {
+            if (v < 0)
+                throw std::runtime_error{"negative value"};
+        }
+
+        int value;
+    };
+}
+
+static_assert(DefaultCommittable<zero::atomic::CircularBuffer<std::string>>);
+static_assert(!DefaultCommittable<zero::atomic::CircularBuffer<Fragile>>);
 
 TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
-    const auto capacity = GENERATE(2uz, take(1, random(3uz, 1024uz)));
+    const auto capacity = GENERATE(2uz, 17uz, take(1, random(3uz, 1024uz)));
     const auto element = GENERATE(take(1, randomString(1, 1024)));
 
     zero::atomic::CircularBuffer<std::string> buffer{capacity};
@@ -17,8 +39,7 @@ TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
             if (!index)
                 throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
 
-            buffer[*index] = element;
-            buffer.commit(*index);
+            buffer.commit(*index, element);
         }
 
         REQUIRE(buffer.size() == size);
@@ -39,8 +60,7 @@ TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
             if (!index)
                 throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
 
-            buffer[*index] = element;
-            buffer.commit(*index);
+            buffer.commit(*index, element);
             REQUIRE_FALSE(buffer.empty());
         }
     }
@@ -57,8 +77,7 @@ TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
                 if (!index)
                     throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
 
-                buffer[*index] = element;
-                buffer.commit(*index);
+                buffer.commit(*index, element);
             }
 
             REQUIRE(buffer.full());
@@ -72,8 +91,7 @@ TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
             if (!index)
                 throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
 
-            buffer[*index] = element;
-            buffer.commit(*index);
+            buffer.commit(*index, element);
         }
 
         const auto index = buffer.acquire();
@@ -104,8 +122,7 @@ TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
             if (!index)
                 throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
 
-            buffer[*index] = element;
-            buffer.commit(*index);
+            buffer.commit(*index, element);
 
             REQUIRE(buffer.acquire() == index);
         }
@@ -114,4 +131,383 @@ TEST_CASE("lock-free circular buffer", "[atomic::circular_buffer]") {
             REQUIRE_FALSE(buffer.acquire());
         }
     }
+
+    SECTION("produce") {
+        SECTION("success") {
+            std::size_t calls{0};
+
+            REQUIRE(buffer.produce(capacity, [&] {
+                ++calls;
+                return element;
+            }) == capacity - 1);
+
+            REQUIRE(calls == capacity - 1);
+            REQUIRE(buffer.full());
+
+            const auto index = buffer.acquire();
+            REQUIRE(index);
+            REQUIRE(buffer[*index] == element);
+        }
+
+        SECTION("failure") {
+            buffer.produce(capacity - 1, [] {
+                return std::string{};
+            });
+
+            REQUIRE(buffer.produce(1, [] {
+                return std::string{};
+            }) == 0);
+        }
+    }
+
+    SECTION("consume") {
+        SECTION("success") {
+            const auto count = GENERATE_REF(take(1, random(1uz, capacity - 1)));
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto index = buffer.reserve();
+
+                if (!index)
+                    throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
+
+                buffer.commit(*index, element);
+            }
+
+            std::vector<std::string> elements;
+
+            REQUIRE(buffer.consume(capacity, [&](std::string &slot) {
+                elements.push_back(std::move(slot));
+            }) == count);
+
+            REQUIRE(elements == std::vector(count, element));
+            REQUIRE(buffer.empty());
+        }
+
+        SECTION("failure") {
+            REQUIRE(buffer.consume(capacity, [](std::string &) {
+            }) == 0);
+        }
+    }
+}
+
+TEST_CASE("fixed-size lock-free circular buffer", "[atomic::circular_buffer]") {
+    const auto element = GENERATE(take(1, randomString(1, 1024)));
+
+    zero::atomic::CircularBuffer<std::string, 8> buffer;
+    REQUIRE(buffer.capacity() == 9);
+    REQUIRE(buffer.empty());
+
+    for (std::size_t i{0}; i < 8; ++i) {
+        const auto index = buffer.reserve();
+        REQUIRE(index == i);
+
+        buffer.commit(*index, element);
+    }
+
+    REQUIRE(buffer.full());
+    REQUIRE(buffer.size() == 8);
+    REQUIRE_FALSE(buffer.reserve());
+
+    for (std::size_t i{0}; i < 3; ++i) {
+        const auto index = buffer.acquire();
+        REQUIRE(index == i);
+        REQUIRE(buffer[*index] == element);
+        buffer.release(*index);
+    }
+
+    std::size_t calls{0};
+
+    REQUIRE(buffer.produce(8, [&] {
+        ++calls;
+        return element;
+    }) == 3);
+
+    REQUIRE(calls == 3);
+    REQUIRE(buffer.full());
+
+    std::vector<std::string> elements;
+
+    REQUIRE(buffer.consume(9, [&](std::string &slot) {
+        elements.push_back(std::move(slot));
+    }) == 8);
+
+    REQUIRE(elements == std::vector(8, element));
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("circular buffer element lifetime", "[atomic::circular_buffer]") {
+    struct Counted {
+        explicit Counted(std::size_t &count) : counter{&count} {
+            ++*counter;
+        }
+
+        Counted(const Counted &rhs) : counter{rhs.counter} {
+            ++*counter;
+        }
+
+        ~Counted() {
+            --*counter;
+        }
+
+        std::size_t *counter;
+    };
+
+    std::size_t count{0};
+
+    {
+        zero::atomic::CircularBuffer<Counted> buffer{8};
+        REQUIRE(count == 0);
+
+        for (std::size_t i{0}; i < 5; ++i) {
+            const auto index = buffer.reserve();
+            REQUIRE(index);
+            buffer.commit(*index, count);
+        }
+
+        REQUIRE(count == 5);
+
+        REQUIRE(buffer.produce(2, [&] {
+            return Counted{count};
+        }) == 2);
+
+        REQUIRE(count == 7);
+
+        const auto index = buffer.acquire();
+        REQUIRE(index);
+        buffer.release(*index);
+        REQUIRE(count == 6);
+
+        REQUIRE(buffer.consume(2, [](const Counted &) {
+        }) == 2);
+
+        REQUIRE(count == 4);
+        REQUIRE(buffer.acquire());
+    }
+
+    REQUIRE(count == 0);
+}
+
+TEST_CASE("circular buffer slot mapping", "[atomic::circular_buffer]") {
+    // 8 slots are masked, 7 and 9 are mapped with a division
+    const auto capacity = GENERATE(9uz, 8uz, 10uz);
+    const auto length = capacity - 1;
+
+    zero::atomic::CircularBuffer<std::size_t> buffer{capacity};
+
+    SECTION("single") {
+        for (std::size_t position{0}; position < length * 3; ++position) {
+            const auto index = buffer.reserve();
+            REQUIRE(index == position % length);
+            buffer.commit(*index, position);
+
+            const auto acquired = buffer.acquire();
+            REQUIRE(acquired == index);
+            REQUIRE(buffer[*acquired] == position);
+            buffer.release(*acquired);
+        }
+    }
+
+    SECTION("batch") {
+        // batches of a size prime to the number of slots end on every slot in turn
+        std::size_t next{0};
+        std::size_t expected{0};
+
+        for (std::size_t i{0}; i < length * 3; ++i) {
+            REQUIRE(buffer.produce(3, [&] {
+                return next++;
+            }) == 3);
+
+            REQUIRE(buffer.consume(3, [&](const std::size_t value) {
+                REQUIRE(value == expected++);
+            }) == 3);
+
+            REQUIRE(buffer.empty());
+        }
+    }
+
+    SECTION("full lap") {
+        for (std::size_t lap{0}; lap < 3; ++lap) {
+            REQUIRE(buffer.produce(capacity, [&, i = 0uz] mutable {
+                return lap * length + i++;
+            }) == length);
+
+            REQUIRE(buffer.full());
+            REQUIRE(buffer.size() == length);
+
+            for (std::size_t i{0}; i < length; ++i) {
+                const auto index = buffer.acquire();
+                REQUIRE(index == i);
+                REQUIRE(buffer[*index] == lap * length + i);
+                buffer.release(*index);
+            }
+
+            REQUIRE(buffer.empty());
+        }
+    }
+}
+
+TEST_CASE("circular buffer concurrency testing", "[atomic::circular_buffer]") {
+    const auto capacity = GENERATE(2uz, 5uz, 8uz, 17uz, take(1, random(3uz, 1024uz)));
+    const auto producers = GENERATE(1uz, 4uz);
+    const auto consumers = GENERATE(1uz, 3uz);
+    const auto times = GENERATE(take(1, random(1uz, 102400uz)));
+
+    zero::atomic::CircularBuffer<std::size_t> buffer{capacity};
+
+    std::atomic<std::size_t> remaining{producers};
+    std::list<std::thread> threads;
+    std::vector<std::vector<std::size_t>> received(consumers);
+
+    // odd producers claim slot by slot, even ones in batches, so that both paths race each other
+    for (std::size_t i{0}; i < producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (std::size_t j{i}; j < times;) {
+                if (i % 2 == 1) {
+                    const auto index = buffer.reserve();
+
+                    if (!index) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    buffer.commit(*index, j);
+                    j += producers;
+                    continue;
+                }
+
+                if (buffer.produce((times - j + producers - 1) / producers, [&] {
+                    const auto value = j;
+                    j += producers;
+                    return value;
+                }) == 0)
+                    std::this_thread::yield();
+            }
+
+            --remaining;
+        });
+    }
+
+    for (std::size_t i{0}; i < consumers; ++i) {
+        threads.emplace_back([&, i] {
+            auto &values = received[i];
+
+            const auto drain = [&] {
+                if (i % 2 == 1) {
+                    const auto index = buffer.acquire();
+
+                    if (!index)
+                        return false;
+
+                    values.push_back(buffer[*index]);
+                    buffer.release(*index);
+                    return true;
+                }
+
+                return buffer.consume(capacity, [&](const std::size_t value) {
+                    values.push_back(value);
+                }) > 0;
+            };
+
+            while (remaining > 0) {
+                if (!drain())
+                    std::this_thread::yield();
+            }
+
+            while (drain()) {
+            }
+        });
+    }
+
+    for (auto &thread: threads)
+        thread.join();
+
+    auto values = received | std::views::join | std::ranges::to<std::vector>();
+    std::ranges::sort(values);
+
+    REQUIRE(values == (std::views::iota(0uz, times) | std::ranges::to<std::vector>()));
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("circular buffer throwing constructor", "[atomic::circular_buffer]") {
+    zero::atomic::CircularBuffer<Fragile> buffer{8};
+
+    SECTION("commit") {
+        for (const auto v: {1, -1, 2}) {
+            const auto index = buffer.reserve();
+            REQUIRE(index);
+
+            if (v < 0)
+                REQUIRE_THROWS_AS(buffer.commit(*index, v), std::runtime_error);
+            else
+                buffer.commit(*index, v);
+        }
+
+        auto index = buffer.acquire();
+        REQUIRE(index);
+        REQUIRE(buffer[*index].value == 1);
+        buffer.release(*index);
+
+        index = buffer.acquire();
+        REQUIRE(index);
+        REQUIRE(buffer[*index].value == 2);
+        buffer.release(*index);
+
+        REQUIRE_FALSE(buffer.acquire());
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("produce") {
+        REQUIRE_THROWS_AS(
+            buffer.produce(5, [i = 0]() mutable {
+                ++i;
+                return Fragile{i == 3 ? -1 : i};
+            }),
+            std::runtime_error
+        );
+
+        std::vector<int> values;
+
+        REQUIRE(buffer.consume(7, [&](const Fragile &fragile) {
+            values.push_back(fragile.value);
+        }) == 2);
+
+        REQUIRE(values == std::vector{1, 2});
+        REQUIRE(buffer.empty());
+
+        // every slot of the batch was handed back
+        REQUIRE(buffer.produce(7, [] {
+            return Fragile{0};
+        }) == 7);
+    }
+
+    SECTION("consume") {
+        REQUIRE(buffer.produce(3, [i = 0]() mutable {
+            return Fragile{i++};
+        }) == 3);
+
+        REQUIRE_THROWS_AS(
+            buffer.consume(3, [](const Fragile &) {
+                throw std::runtime_error{"consumer failure"};
+            }),
+            std::runtime_error
+        );
+
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.produce(7, [] {
+            return Fragile{0};
+        }) == 7);
+    }
+}
+
+TEST_CASE("commit a default-constructed value", "[atomic::circular_buffer]") {
+    zero::atomic::CircularBuffer<std::string> buffer{4};
+
+    const auto reserved = buffer.reserve();
+    REQUIRE(reserved);
+    buffer.commit(*reserved);
+
+    const auto index = buffer.acquire();
+    REQUIRE(index);
+    REQUIRE(buffer[*index].empty());
+    buffer.release(*index);
 }
@@ -74,3 +74,53 @@ TEST_CASE("manual-reset event", "[atomic::event]") {
         REQUIRE_FALSE(event.isSet());
     }
 }
+
+TEST_CASE("event count", "[atomic::event]") {
+    using namespace std::chrono_literals;
+
+    zero::atomic::EventCount event;
+
+    SECTION("notify") {
+        std::atomic<bool> ready;
+
+        std::thread thread{
+            [&] {
+                std::this_thread::sleep_for(10ms);
+                ready = true;
+                event.notify();
+            }
+        };
+        Z_DEFER(thread.join());
+
+        while (true) {
+            const auto key = event.prepare();
+
+            if (ready) {
+                event.cancel();
+                break;
+            }
+
+            REQUIRE(event.wait(key));
+        }
+
+        REQUIRE(ready);
+    }
+
+    SECTION("notified before wait") {
+        const auto key = event.prepare();
+        event.notify();
+        REQUIRE(event.wait(key, 10ms));
+    }
+
+    SECTION("notify without waiters") {
+        event.notify();
+
+        const auto key = event.prepare();
+        REQUIRE_ERROR(event.wait(key, 10ms), std::errc::timed_out);
+    }
+
+    SECTION("timeout") {
+        const auto key = event.prepare();
+        REQUIRE_ERROR(event.wait(key, 10ms), std::errc::timed_out);
+    }
+}
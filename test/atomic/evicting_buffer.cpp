@@ -0,0 +1,147 @@
+#include <catch_extensions.h>
+#include <zero/atomic/evicting_buffer.h>
+#include <thread>
+#include <ranges>
+
+TEST_CASE("evicting buffer", "[atomic::evicting_buffer]") {
+    const auto capacity = GENERATE(1uz, take(1, random(2uz, 1024uz)));
+    const auto element = GENERATE(take(1, randomString(1, 1024)));
+
+    zero::atomic::EvictingBuffer<std::string> buffer{capacity};
+
+    SECTION("size") {
+        const auto size = GENERATE_REF(take(1, random(0uz, capacity)));
+
+        for (std::size_t i{0}; i < size; ++i)
+            REQUIRE(buffer.push(element));
+
+        REQUIRE(buffer.size() == size);
+    }
+
+    SECTION("capacity") {
+        REQUIRE(buffer.capacity() == capacity);
+    }
+
+    SECTION("is empty") {
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.push(element));
+        REQUIRE_FALSE(buffer.empty());
+    }
+
+    SECTION("is full") {
+        for (std::size_t i{0}; i < capacity; ++i)
+            REQUIRE(buffer.push(element));
+
+        REQUIRE(buffer.full());
+
+        auto value = element;
+        REQUIRE_FALSE(buffer.push(std::move(value)));
+        REQUIRE(value == element);
+    }
+
+    SECTION("evict") {
+        for (std::size_t i{0}; i < capacity * 3; ++i)
+            REQUIRE(buffer.pushEvicting(std::to_string(i)) == i >= capacity);
+
+        REQUIRE(buffer.full());
+
+        std::vector<std::string> elements;
+
+        REQUIRE(buffer.consume(capacity, [&](std::string &slot) {
+            elements.push_back(std::move(slot));
+        }) == capacity);
+
+        REQUIRE(
+            elements == (
+                std::views::iota(capacity * 2, capacity * 3)
+                | std::views::transform([](const auto i) { return std::to_string(i); })
+                | std::ranges::to<std::vector>()
+            )
+        );
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("throwing consumer") {
+        REQUIRE(buffer.push(element));
+
+        REQUIRE_THROWS_AS(
+            buffer.consume(capacity, [](const std::string &) {
+                throw std::runtime_error{"consumer failure"};
+            }),
+            std::runtime_error
+        );
+
+        // the element stays and the ring is not left busy
+        REQUIRE(buffer.size() == 1);
+
+        for (std::size_t i{0}; i < capacity; ++i)
+            buffer.pushEvicting(element);
+
+        REQUIRE(buffer.full());
+    }
+
+    SECTION("consume") {
+        const auto count = GENERATE_REF(take(1, random(1uz, capacity)));
+
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(buffer.push(element));
+
+        std::vector<std::string> elements;
+
+        REQUIRE(buffer.consume(capacity, [&](std::string &slot) {
+            elements.push_back(std::move(slot));
+        }) == count);
+
+        REQUIRE(elements == std::vector(count, element));
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.consume(capacity, [](std::string &) {
+        }) == 0);
+    }
+}
+
+TEST_CASE("evicting buffer concurrency testing", "[atomic::evicting_buffer]") {
+    const auto capacity = GENERATE(1uz, take(3, random(2uz, 1024uz)));
+    const auto times = GENERATE(take(3, random(1uz, 102400uz)));
+
+    zero::atomic::EvictingBuffer<std::size_t> buffer{capacity};
+
+    std::atomic<bool> done{false};
+    std::size_t evicted{0};
+
+    std::thread producer{
+        [&] {
+            for (std::size_t i{0}; i < times; ++i) {
+                if (buffer.pushEvicting(i))
+                    ++evicted;
+            }
+
+            done = true;
+        }
+    };
+
+    std::size_t received{0};
+    std::size_t last{0};
+    std::size_t disorders{0};
+
+    const auto drain = [&] {
+        return buffer.consume(capacity, [&](const std::size_t value) {
+            if (received > 0 && value <= last)
+                ++disorders;
+
+            last = value;
+            ++received;
+        });
+    };
+
+    while (!done) {
+        if (drain() == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+    drain();
+
+    REQUIRE(disorders == 0);
+    REQUIRE(last == times - 1);
+    REQUIRE(received + evicted == times);
+}
@@ -0,0 +1,199 @@
+#include <catch_extensions.h>
+#include <zero/atomic/segmented_buffer.h>
+#include <thread>
+
+TEST_CASE("segmented buffer", "[atomic::segmented_buffer]") {
+    const auto element = GENERATE(take(1, randomString(1, 1024)));
+    const auto count = GENERATE(1uz, 4uz, take(1, random(5uz, 1024uz)));
+
+    zero::atomic::SegmentedBuffer<std::string, 4> buffer;
+
+    SECTION("reserve and acquire") {
+        REQUIRE(buffer.empty());
+        REQUIRE_FALSE(buffer.acquire());
+
+        const auto index = buffer.reserve();
+        REQUIRE(index);
+        REQUIRE_FALSE(buffer.acquire());
+        // a claimed slot already counts
+        REQUIRE_FALSE(buffer.empty());
+        REQUIRE(buffer.size() == 1);
+
+        buffer.commit(*index, element);
+        REQUIRE_FALSE(buffer.empty());
+        REQUIRE(buffer.acquire() == index);
+        REQUIRE(buffer[*index] == element);
+
+        buffer.release(*index);
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("grow and shrink") {
+        for (std::size_t round{0}; round < 3; ++round) {
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto index = buffer.reserve();
+                REQUIRE(index);
+                buffer.commit(*index, std::to_string(i));
+            }
+
+            REQUIRE_FALSE(buffer.full());
+            REQUIRE(buffer.size() == count);
+
+            for (std::size_t i{0}; i < count; ++i) {
+                const auto index = buffer.acquire();
+                REQUIRE(index);
+                REQUIRE(buffer[*index] == std::to_string(i));
+                buffer.release(*index);
+            }
+
+            REQUIRE(buffer.empty());
+            REQUIRE(buffer.size() == 0);
+        }
+    }
+
+    SECTION("produce and consume") {
+        std::size_t i{0};
+
+        REQUIRE(buffer.produce(count, [&] {
+            return std::to_string(i++);
+        }) == count);
+
+        std::vector<std::string> elements;
+
+        REQUIRE(buffer.consume(count * 2, [&](std::string &slot) {
+            elements.push_back(std::move(slot));
+        }) == count);
+
+        REQUIRE(elements.size() == count);
+        REQUIRE(elements.front() == "0");
+        REQUIRE(elements.back() == std::to_string(count - 1));
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("pending values are destroyed") {
+        for (std::size_t i{0}; i < count; ++i)
+            buffer.commit(*buffer.reserve(), element);
+
+        REQUIRE(buffer.acquire());
+    }
+}
+
+TEST_CASE("segmented buffer soft limit", "[atomic::segmented_buffer]") {
+    std::vector<std::size_t> exceeded;
+
+    zero::atomic::SegmentedBuffer<int, 4> buffer{
+        5,
+        [&](const std::size_t size) {
+            exceeded.push_back(size);
+        }
+    };
+
+    REQUIRE(buffer.produce(5, [] {
+        return 0;
+    }) == 5);
+
+    REQUIRE(exceeded.empty());
+
+    REQUIRE(buffer.produce(3, [] {
+        return 0;
+    }) == 3);
+
+    REQUIRE(exceeded == std::vector{8uz});
+
+    buffer.commit(*buffer.reserve(), 0);
+    REQUIRE(exceeded == std::vector{8uz});
+
+    REQUIRE(buffer.consume(4, [](int) {
+    }) == 4);
+
+    buffer.commit(*buffer.reserve(), 0);
+    REQUIRE(exceeded == std::vector{8uz, 6uz});
+}
+
+TEST_CASE("segmented buffer concurrency testing", "[atomic::segmented_buffer]") {
+    const auto times = GENERATE(take(3, random(1uz, 102400uz)));
+
+    zero::atomic::SegmentedBuffer<std::size_t, 8> buffer;
+
+    std::thread producer{
+        [&] {
+            for (std::size_t i{0}; i < times;) {
+                if (i % 2 == 0) {
+                    buffer.commit(*buffer.reserve(), i++);
+                    continue;
+                }
+
+                i += buffer.produce(std::min(3uz, times - i), [&, j = i]() mutable {
+                    return j++;
+                });
+            }
+        }
+    };
+
+    std::size_t received{0};
+    std::size_t mismatches{0};
+
+    while (received < times) {
+        const auto n = buffer.consume(5, [&](const std::size_t value) {
+            if (value != received++)
+                ++mismatches;
+        });
+
+        if (n == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("segmented buffer exception safety", "[atomic::segmented_buffer]") {
+    struct Fragile {
+        explicit Fragile(const int v) : value{v} {
+            if (v < 0)
+                throw std::runtime_error{"negative value"};
+        }
+
+        int value;
+    };
+
+    zero::atomic::SegmentedBuffer<Fragile, 4> buffer;
+
+    SECTION("commit") {
+        buffer.commit(*buffer.reserve(), 1);
+        REQUIRE_THROWS_AS(buffer.commit(*buffer.reserve(), -1), std::runtime_error);
+        buffer.commit(*buffer.reserve(), 2);
+
+        auto slot = buffer.acquire();
+        REQUIRE(slot);
+        REQUIRE(buffer[*slot].value == 1);
+        buffer.release(*slot);
+
+        slot = buffer.acquire();
+        REQUIRE(slot);
+        REQUIRE(buffer[*slot].value == 2);
+        buffer.release(*slot);
+
+        REQUIRE_FALSE(buffer.acquire());
+    }
+
+    SECTION("produce") {
+        // crosses a segment boundary after the failure, so that the empty slots are reclaimed with their segment
+        REQUIRE_THROWS_AS(
+            buffer.produce(7, [i = 0]() mutable {
+                ++i;
+                return Fragile{i == 3 ? -1 : i};
+            }),
+            std::runtime_error
+        );
+
+        std::vector<int> values;
+
+        REQUIRE(buffer.consume(7, [&](const Fragile &fragile) {
+            values.push_back(fragile.value);
+        }) == 2);
+
+        REQUIRE(values == std::vector{1, 2});
+        REQUIRE(buffer.empty());
+    }
+}
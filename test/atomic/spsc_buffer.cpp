@@ -0,0 +1,207 @@
+#include <catch_extensions.h>
+#include <zero/atomic/spsc_buffer.h>
+#include <zero/error.h>
+#include <thread>
+
+TEST_CASE("single-producer single-consumer buffer", "[atomic::spsc_buffer]") {
+    const auto capacity = GENERATE(2uz, take(1, random(3uz, 1024uz)));
+    const auto element = GENERATE(take(1, randomString(1, 1024)));
+
+    zero::atomic::SPSCBuffer<std::string> buffer{capacity};
+
+    SECTION("size") {
+        const auto size = GENERATE_REF(take(1, random(0uz, capacity - 1)));
+
+        for (std::size_t i{0}; i < size; ++i) {
+            const auto index = buffer.reserve();
+
+            if (!index)
+                throw zero::error::StacktraceError<std::runtime_error>{"Failed to reserve buffer slot"};
+
+            buffer.commit(*index, element);
+        }
+
+        REQUIRE(buffer.size() == size);
+    }
+
+    SECTION("capacity") {
+        REQUIRE(buffer.capacity() == capacity);
+    }
+
+    SECTION("is empty") {
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.produce(1, [&] {
+            return element;
+        }) == 1);
+        REQUIRE_FALSE(buffer.empty());
+    }
+
+    SECTION("is full") {
+        REQUIRE_FALSE(buffer.full());
+        REQUIRE(buffer.produce(capacity, [&] {
+            return element;
+        }) == capacity - 1);
+        REQUIRE(buffer.full());
+        REQUIRE_FALSE(buffer.reserve());
+    }
+
+    SECTION("reserve and acquire") {
+        REQUIRE_FALSE(buffer.acquire());
+
+        const auto index = buffer.reserve();
+        REQUIRE(index == 0);
+
+        REQUIRE_FALSE(buffer.acquire());
+
+        buffer.commit(*index, element);
+        REQUIRE(buffer.acquire() == index);
+        REQUIRE(buffer[*index] == element);
+
+        buffer.release(*index);
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("wrap around") {
+        for (std::size_t i{0}; i < capacity * 3; ++i) {
+            const auto index = buffer.reserve();
+            REQUIRE(index);
+
+            buffer.commit(*index, std::to_string(i));
+
+            const auto slot = buffer.acquire();
+            REQUIRE(slot == index);
+            REQUIRE(buffer[*slot] == std::to_string(i));
+            buffer.release(*slot);
+        }
+
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("consume") {
+        const auto count = GENERATE_REF(take(1, random(1uz, capacity - 1)));
+
+        REQUIRE(buffer.produce(count, [&] {
+            return element;
+        }) == count);
+
+        std::vector<std::string> elements;
+
+        REQUIRE(buffer.consume(capacity, [&](std::string &slot) {
+            elements.push_back(std::move(slot));
+        }) == count);
+
+        REQUIRE(elements == std::vector(count, element));
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.consume(capacity, [](std::string &) {
+        }) == 0);
+    }
+}
+
+TEST_CASE("single-producer single-consumer buffer concurrency testing", "[atomic::spsc_buffer]") {
+    const auto capacity = GENERATE(2uz, take(3, random(3uz, 1024uz)));
+    const auto times = GENERATE(take(3, random(1uz, 102400uz)));
+
+    zero::atomic::SPSCBuffer<std::size_t> buffer{capacity};
+
+    std::thread producer{
+        [&] {
+            for (std::size_t i{0}; i < times;) {
+                const auto index = buffer.reserve();
+
+                if (!index) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                buffer.commit(*index, i++);
+            }
+        }
+    };
+
+    std::size_t received{0};
+    std::size_t mismatches{0};
+
+    while (received < times) {
+        const auto index = buffer.acquire();
+
+        if (!index) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (buffer[*index] != received)
+            ++mismatches;
+
+        buffer.release(*index);
+        ++received;
+    }
+
+    producer.join();
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("single-producer single-consumer buffer exception safety", "[atomic::spsc_buffer]") {
+    struct Fragile {
+        explicit Fragile(const int v) : value{v} {
+            if (v < 0)
+                throw std::runtime_error{"negative value"};
+        }
+
+        int value;
+    };
+
+    zero::atomic::SPSCBuffer<Fragile> buffer{8};
+
+    SECTION("commit") {
+        const auto index = buffer.reserve();
+        REQUIRE(index);
+        REQUIRE_THROWS_AS(buffer.commit(*index, -1), std::runtime_error);
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.reserve() == index);
+    }
+
+    SECTION("produce") {
+        REQUIRE_THROWS_AS(
+            buffer.produce(5, [i = 0]() mutable {
+                ++i;
+                return Fragile{i == 3 ? -1 : i};
+            }),
+            std::runtime_error
+        );
+
+        REQUIRE(buffer.size() == 2);
+
+        std::vector<int> values;
+
+        REQUIRE(buffer.consume(7, [&](const Fragile &fragile) {
+            values.push_back(fragile.value);
+        }) == 2);
+
+        REQUIRE(values == std::vector{1, 2});
+    }
+
+    SECTION("consume") {
+        REQUIRE(buffer.produce(3, [i = 0]() mutable {
+            return Fragile{i++};
+        }) == 3);
+
+        REQUIRE_THROWS_AS(
+            buffer.consume(3, [](const Fragile &fragile) {
+                if (fragile.value == 1)
+                    throw std::runtime_error{"consumer failure"};
+            }),
+            std::runtime_error
+        );
+
+        // the value that failed is still there
+        REQUIRE(buffer.size() == 2);
+
+        std::vector<int> values;
+
+        REQUIRE(buffer.consume(3, [&](const Fragile &fragile) {
+            values.push_back(fragile.value);
+        }) == 2);
+
+        REQUIRE(values == std::vector{1, 2});
+    }
+}
@@ -0,0 +1,151 @@
+#include <catch_extensions.h>
+#include <zero/atomic/work_stealing_deque.h>
+#include <thread>
+#include <vector>
+#include <numeric>
+
+TEST_CASE("work-stealing deque", "[atomic::work_stealing_deque]") {
+    zero::atomic::WorkStealingDeque<int> deque{2};
+    REQUIRE(deque.empty());
+
+    SECTION("pop") {
+        REQUIRE_FALSE(deque.pop());
+
+        deque.push(1);
+        deque.push(2);
+        deque.push(3);
+        REQUIRE(deque.size() == 3);
+
+        REQUIRE(deque.pop() == 3);
+        REQUIRE(deque.pop() == 2);
+        REQUIRE(deque.pop() == 1);
+        REQUIRE_FALSE(deque.pop());
+        REQUIRE(deque.empty());
+    }
+
+    SECTION("steal") {
+        REQUIRE_FALSE(deque.steal());
+
+        deque.push(1);
+        deque.push(2);
+        deque.push(3);
+
+        REQUIRE(deque.steal() == 1);
+        REQUIRE(deque.steal() == 2);
+        REQUIRE(deque.pop() == 3);
+        REQUIRE_FALSE(deque.steal());
+    }
+
+    SECTION("concurrent") {
+        constexpr auto N = 100000;
+        constexpr auto Thieves = 4;
+
+        std::atomic<bool> done;
+        std::array<std::vector<int>, Thieves + 1> results;
+        std::vector<std::thread> threads;
+
+        for (std::size_t i{0}; i < Thieves; ++i) {
+            threads.emplace_back([&, i] {
+                while (true) {
+                    const auto stopping = done.load();
+
+                    if (const auto element = deque.steal()) {
+                        results[i].push_back(*element);
+                        continue;
+                    }
+
+                    if (stopping && deque.empty())
+                        break;
+                }
+            });
+        }
+
+        for (int i{0}; i < N; ++i) {
+            deque.push(i);
+
+            if (i % 3 == 0) {
+                if (const auto element = deque.pop())
+                    results[Thieves].push_back(*element);
+            }
+        }
+
+        while (const auto element = deque.pop())
+            results[Thieves].push_back(*element);
+
+        done = true;
+
+        for (auto &thread: threads)
+            thread.join();
+
+        std::vector<int> elements;
+
+        for (const auto &result: results)
+            elements.insert(elements.end(), result.begin(), result.end());
+
+        std::ranges::sort(elements);
+
+        std::vector<int> expected(N);
+        std::iota(expected.begin(), expected.end(), 0);
+
+        REQUIRE(elements == expected);
+    }
+
+    SECTION("publication") {
+        // thieves read what the owner wrote right before pushing, which only the release of the bottom makes visible
+        constexpr auto N = 100000;
+        constexpr auto Thieves = 4;
+
+        struct Payload {
+            int value;
+            int complement;
+        };
+
+        zero::atomic::WorkStealingDeque<Payload *> pointers{2};
+        const auto payloads = std::make_unique<Payload[]>(N);
+
+        std::atomic<bool> done;
+        std::atomic<int> stolen{0};
+        std::atomic<int> corrupted{0};
+        std::vector<std::thread> threads;
+
+        for (std::size_t i{0}; i < Thieves; ++i) {
+            threads.emplace_back([&] {
+                while (true) {
+                    const auto stopping = done.load();
+
+                    if (const auto element = pointers.steal()) {
+                        if ((*element)->complement != ~(*element)->value)
+                            ++corrupted;
+
+                        ++stolen;
+                        continue;
+                    }
+
+                    if (stopping && pointers.empty())
+                        break;
+                }
+            });
+        }
+
+        int popped{0};
+
+        for (int i{0}; i < N; ++i) {
+            payloads[i] = {i, ~i};
+            pointers.push(&payloads[i]);
+
+            if (i % 5 == 0 && pointers.pop())
+                ++popped;
+        }
+
+        while (pointers.pop())
+            ++popped;
+
+        done = true;
+
+        for (auto &thread: threads)
+            thread.join();
+
+        REQUIRE(corrupted == 0);
+        REQUIRE(stolen + popped == N);
+    }
+}
@@ -1,6 +1,12 @@
 #include <catch_extensions.h>
 #include <zero/concurrent/channel.h>
 #include <future>
+#include <numeric>
+
+#ifdef __linux__
+#include <csignal>
+#include <pthread.h>
+#endif
 
 TEST_CASE("channel error condition", "[concurrent::channel]") {
     const std::error_condition condition{zero::concurrent::ChannelError::Disconnected};
@@ -486,3 +492,808 @@ TEST_CASE("channel concurrency testing", "[concurrent::channel]") {
 
     REQUIRE(counter == times * 2);
 }
+
+#ifdef __linux__
+TEST_CASE("channel interrupted by a signal", "[concurrent::channel]") {
+    using namespace std::chrono_literals;
+
+    // without `SA_RESTART`, so that a blocked wait fails with `EINTR`
+    struct sigaction action{}, previous{};
+    action.sa_handler = [](int) {
+    };
+
+    REQUIRE(sigaction(SIGUSR1, &action, &previous) == 0);
+    Z_DEFER(sigaction(SIGUSR1, &previous, nullptr));
+
+    auto [sender, receiver] = zero::concurrent::channel<int>();
+
+    const auto timeout = GENERATE(std::optional<std::chrono::milliseconds>{}, std::optional{300ms});
+
+    std::promise<pthread_t> promise;
+
+    auto future = std::async(std::launch::async, [&] {
+        promise.set_value(pthread_self());
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = receiver.receive(timeout);
+
+        return std::pair{result, std::chrono::steady_clock::now() - start};
+    });
+
+    const auto thread = promise.get_future().get();
+
+    for (int i{0}; i < 5; ++i) {
+        std::this_thread::sleep_for(40ms);
+        REQUIRE(pthread_kill(thread, SIGUSR1) == 0);
+    }
+
+    if (!timeout) {
+        zero::error::guard(sender.send(1));
+
+        const auto [result, elapsed] = future.get();
+        REQUIRE(result == 1);
+        return;
+    }
+
+    const auto [result, elapsed] = future.get();
+    REQUIRE_ERROR(result, zero::concurrent::ReceiveError::Timeout);
+    REQUIRE(elapsed >= *timeout);
+    // the timeout does not start over with each signal
+    REQUIRE(elapsed < *timeout + 150ms);
+}
+#endif
+
+TEST_CASE("channel batch", "[concurrent::channel]") {
+    using namespace std::chrono_literals;
+
+    const auto capacity = GENERATE(1uz, take(1, random(2uz, 1024uz)));
+    const auto elements = GENERATE_REF(take(1, chunk(capacity * 2, randomString(1, 64))));
+
+    auto [sender, receiver] = zero::concurrent::channel<std::string>(capacity);
+
+    SECTION("try send many") {
+        SECTION("partial") {
+            REQUIRE(sender.trySendMany(elements) == capacity);
+            REQUIRE(sender.full());
+
+            std::vector<std::string> received;
+            REQUIRE(receiver.tryReceiveMany(std::back_inserter(received), elements.size()) == capacity);
+            REQUIRE(received == std::vector(elements.begin(), elements.begin() + static_cast<std::ptrdiff_t>(capacity)));
+        }
+
+        SECTION("empty range") {
+            REQUIRE(sender.trySendMany(std::vector<std::string>{}) == 0);
+        }
+
+        SECTION("rvalue range") {
+            auto [ptrSender, ptrReceiver] = zero::concurrent::channel<std::unique_ptr<std::string>>(capacity);
+
+            std::vector<std::unique_ptr<std::string>> pointers;
+
+            for (const auto &element: elements | std::views::take(capacity))
+                pointers.push_back(std::make_unique<std::string>(element));
+
+            REQUIRE(ptrSender.trySendMany(std::move(pointers)) == capacity);
+
+            const auto pointer = ptrReceiver.tryReceive();
+            REQUIRE(pointer);
+            REQUIRE(**pointer == elements.front());
+        }
+
+        SECTION("full") {
+            zero::error::guard(sender.trySendMany(elements));
+            REQUIRE_ERROR(sender.trySendMany(elements), zero::concurrent::TrySendError::Full);
+        }
+
+        SECTION("disconnected") {
+            sender.close();
+            REQUIRE_ERROR(sender.trySendMany(elements), zero::concurrent::TrySendError::Disconnected);
+        }
+    }
+
+    SECTION("send many") {
+        SECTION("success") {
+            auto future = std::async([&] {
+                return sender.sendMany(elements);
+            });
+
+            std::vector<std::string> received;
+
+            while (received.size() < elements.size())
+                zero::error::guard(receiver.receiveMany(std::back_inserter(received), elements.size()));
+
+            REQUIRE(future.get() == elements.size());
+            REQUIRE(received == elements);
+        }
+
+        SECTION("move") {
+            auto copy = elements;
+            REQUIRE(sender.sendMany(std::views::as_rvalue(std::span{copy.data(), capacity})) == capacity);
+            REQUIRE(copy.front().empty());
+        }
+
+        SECTION("partial timeout") {
+            REQUIRE(sender.sendMany(elements, 10ms) == capacity);
+        }
+
+        SECTION("timeout") {
+            zero::error::guard(sender.trySendMany(elements));
+            REQUIRE_ERROR(sender.sendMany(elements, 10ms), zero::concurrent::SendError::Timeout);
+        }
+
+        SECTION("disconnected") {
+            sender.close();
+            REQUIRE_ERROR(sender.sendMany(elements), zero::concurrent::SendError::Disconnected);
+        }
+    }
+
+    SECTION("try receive many") {
+        std::vector<std::string> received;
+
+        SECTION("limit") {
+            zero::error::guard(sender.trySendMany(elements));
+            REQUIRE(receiver.tryReceiveMany(std::back_inserter(received), 1) == 1);
+            REQUIRE(received == std::vector{elements.front()});
+        }
+
+        SECTION("zero") {
+            REQUIRE(receiver.tryReceiveMany(std::back_inserter(received), 0) == 0);
+        }
+
+        SECTION("empty") {
+            REQUIRE_ERROR(
+                receiver.tryReceiveMany(std::back_inserter(received), capacity),
+                zero::concurrent::TryReceiveError::Empty
+            );
+        }
+
+        SECTION("disconnected") {
+            sender.close();
+            REQUIRE_ERROR(
+                receiver.tryReceiveMany(std::back_inserter(received), capacity),
+                zero::concurrent::TryReceiveError::Disconnected
+            );
+        }
+    }
+
+    SECTION("receive many") {
+        std::vector<std::string> received;
+
+        SECTION("wait") {
+            auto future = std::async([&] {
+                return receiver.receiveMany(std::back_inserter(received), capacity);
+            });
+
+            REQUIRE(sender.trySend(elements.front()));
+
+            const auto n = future.get();
+            REQUIRE(n);
+            REQUIRE(*n >= 1);
+            REQUIRE(received.front() == elements.front());
+        }
+
+        SECTION("timeout") {
+            REQUIRE_ERROR(
+                receiver.receiveMany(std::back_inserter(received), capacity, 10ms),
+                zero::concurrent::ReceiveError::Timeout
+            );
+        }
+
+        SECTION("disconnected") {
+            sender.close();
+            REQUIRE_ERROR(
+                receiver.receiveMany(std::back_inserter(received), capacity),
+                zero::concurrent::ReceiveError::Disconnected
+            );
+        }
+    }
+}
+
+TEST_CASE("channel batch concurrency testing", "[concurrent::channel]") {
+    const auto capacity = GENERATE(take(3, random(1uz, 1024uz)));
+    const auto batch = GENERATE(take(3, random(1uz, 64uz)));
+    const auto times = GENERATE(take(3, random(1uz, 1024uz)));
+
+    auto [sender, receiver] = zero::concurrent::channel<std::size_t>(capacity);
+
+    std::atomic<std::size_t> sum;
+    std::atomic<std::size_t> counter;
+
+    const auto produce = [&] {
+        std::vector<std::size_t> values(batch);
+        std::iota(values.begin(), values.end(), 1);
+
+        for (std::size_t i{0}; i < times; ++i) {
+            std::span pending{values};
+
+            while (!pending.empty())
+                pending = pending.subspan(zero::error::guard(sender.sendMany(pending)));
+        }
+    };
+
+    const auto consume = [&] {
+        std::vector<std::size_t> values;
+
+        while (true) {
+            values.clear();
+
+            if (const auto result = receiver.receiveMany(std::back_inserter(values), batch); !result) {
+                if (const auto &error = result.error(); error != zero::concurrent::ReceiveError::Disconnected)
+                    throw zero::error::StacktraceError<std::system_error>{error};
+
+                break;
+            }
+
+            sum += std::accumulate(values.begin(), values.end(), std::size_t{0});
+            counter += values.size();
+        }
+    };
+
+    std::array producers{std::async(produce), std::async(produce)};
+    std::array consumers{std::async(consume), std::async(consume)};
+
+    for (auto &future: producers) {
+        REQUIRE_NOTHROW(future.get());
+    }
+
+    sender.close();
+
+    for (auto &future: consumers) {
+        REQUIRE_NOTHROW(future.get());
+    }
+
+    REQUIRE(counter == batch * times * 2);
+    REQUIRE(sum == batch * (batch + 1) / 2 * times * 2);
+}
+
+TEST_CASE("spsc channel", "[concurrent::channel]") {
+    using namespace std::chrono_literals;
+
+    static_assert(!std::is_copy_constructible_v<zero::concurrent::SPSCSender<std::string>>);
+    static_assert(!std::is_copy_constructible_v<zero::concurrent::SPSCReceiver<std::string>>);
+    static_assert(std::is_copy_constructible_v<zero::concurrent::Sender<std::string>>);
+
+    const auto capacity = GENERATE(1uz, take(1, random(2uz, 1024uz)));
+    const auto element = GENERATE(take(1, randomString(1, 1024)));
+
+    auto [sender, receiver] = zero::concurrent::spscChannel<std::string>(capacity);
+
+    SECTION("capacity") {
+        REQUIRE(sender.capacity() == capacity);
+        REQUIRE(receiver.capacity() == capacity);
+    }
+
+    SECTION("try send and receive") {
+        REQUIRE_ERROR(receiver.tryReceive(), zero::concurrent::TryReceiveError::Empty);
+
+        for (std::size_t i{0}; i < capacity; ++i)
+            REQUIRE(sender.trySend(element));
+
+        REQUIRE(sender.full());
+        REQUIRE_ERROR(sender.trySend(element), zero::concurrent::TrySendError::Full);
+        REQUIRE(receiver.tryReceive() == element);
+        REQUIRE(sender.size() == capacity - 1);
+    }
+
+    SECTION("send timeout") {
+        for (std::size_t i{0}; i < capacity; ++i)
+            REQUIRE(sender.trySend(element));
+
+        REQUIRE_ERROR(sender.send(element, 10ms), zero::concurrent::SendError::Timeout);
+    }
+
+    SECTION("receive wait") {
+        auto future = std::async([&] {
+            return receiver.receive();
+        });
+
+        REQUIRE(sender.send(element));
+        REQUIRE(future.get() == element);
+    }
+
+    SECTION("batch") {
+        const std::vector elements(capacity, element);
+        REQUIRE(sender.trySendMany(elements) == capacity);
+
+        std::vector<std::string> received;
+        REQUIRE(receiver.tryReceiveMany(std::back_inserter(received), capacity * 2) == capacity);
+        REQUIRE(received == elements);
+    }
+
+    SECTION("disconnected") {
+        REQUIRE(sender.trySend(element));
+
+        {
+            [[maybe_unused]] const auto s = std::move(sender);
+        }
+
+        REQUIRE(receiver.closed());
+        REQUIRE(receiver.receive() == element);
+        REQUIRE_ERROR(receiver.receive(), zero::concurrent::ReceiveError::Disconnected);
+    }
+}
+
+TEST_CASE("spsc channel concurrency testing", "[concurrent::channel]") {
+    const auto capacity = GENERATE(take(5, random(1uz, 1024uz)));
+    const auto times = GENERATE(take(5, random(1uz, 102400uz)));
+
+    auto [sender, receiver] = zero::concurrent::spscChannel<std::size_t>(capacity);
+
+    auto producer = std::async([&] {
+        for (std::size_t i{0}; i < times; ++i)
+            zero::error::guard(sender.send(i));
+
+        sender.close();
+    });
+
+    std::size_t received{0};
+    std::size_t mismatches{0};
+
+    while (true) {
+        const auto result = receiver.receive();
+
+        if (!result) {
+            REQUIRE(result.error() == zero::concurrent::ReceiveError::Disconnected);
+            break;
+        }
+
+        if (*result != received++)
+            ++mismatches;
+    }
+
+    REQUIRE_NOTHROW(producer.get());
+    REQUIRE(received == times);
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("unbounded channel", "[concurrent::channel]") {
+    const auto element = GENERATE(take(1, randomString(1, 1024)));
+    const auto count = GENERATE(take(3, random(1uz, 1024uz)));
+
+    std::vector<std::size_t> exceeded;
+    auto [sender, receiver] = zero::concurrent::unboundedChannel<std::string>(count / 2, [&](const std::size_t size) {
+        exceeded.push_back(size);
+    });
+
+    SECTION("send and receive") {
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(sender.trySend(element));
+
+        REQUIRE_FALSE(sender.full());
+        REQUIRE(sender.size() == count);
+        REQUIRE(exceeded == std::vector{count / 2 + 1});
+
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(receiver.tryReceive() == element);
+
+        REQUIRE(receiver.empty());
+        REQUIRE_ERROR(receiver.tryReceive(), zero::concurrent::TryReceiveError::Empty);
+
+        REQUIRE(sender.trySendMany(std::vector(count, element)) == count);
+        REQUIRE(exceeded == std::vector{count / 2 + 1, count});
+
+        std::vector<std::string> received;
+        REQUIRE(receiver.tryReceiveMany(std::back_inserter(received), count * 2) == count);
+        REQUIRE(received == std::vector(count, element));
+    }
+
+    SECTION("disconnected") {
+        REQUIRE(sender.trySend(element));
+        sender.close();
+
+        REQUIRE(receiver.receive() == element);
+        REQUIRE_ERROR(receiver.receive(), zero::concurrent::ReceiveError::Disconnected);
+    }
+}
+
+TEST_CASE("unbounded channel concurrency testing", "[concurrent::channel]") {
+    const auto times = GENERATE(take(5, random(1uz, 102400uz)));
+
+    auto [sender, receiver] = zero::concurrent::unboundedChannel<std::size_t>();
+
+    const auto produce = [&] {
+        for (std::size_t i{0}; i < times; ++i)
+            zero::error::guard(sender.send(i));
+    };
+
+    std::atomic<std::size_t> sum;
+
+    const auto consume = [&] {
+        while (true) {
+            const auto result = receiver.receive();
+
+            if (!result) {
+                if (const auto &error = result.error(); error != zero::concurrent::ReceiveError::Disconnected)
+                    throw zero::error::StacktraceError<std::system_error>{error};
+
+                break;
+            }
+
+            sum += *result;
+        }
+    };
+
+    std::array producers{std::async(produce), std::async(produce)};
+    std::array consumers{std::async(consume), std::async(consume)};
+
+    for (auto &future: producers) {
+        REQUIRE_NOTHROW(future.get());
+    }
+
+    sender.close();
+
+    for (auto &future: consumers) {
+        REQUIRE_NOTHROW(future.get());
+    }
+
+    REQUIRE(sum == times * (times - 1));
+}
+
+TEST_CASE("channel select", "[concurrent::channel]") {
+    using namespace std::chrono_literals;
+
+    auto [sender1, receiver1] = zero::concurrent::channel<int>(4);
+    auto [sender2, receiver2] = zero::concurrent::spscChannel<std::string>(4);
+
+    SECTION("try select") {
+        REQUIRE_ERROR(zero::concurrent::trySelect(receiver1, receiver2), zero::concurrent::TryReceiveError::Empty);
+
+        REQUIRE(sender2.trySend("hello"));
+
+        const auto result = zero::concurrent::trySelect(receiver1, receiver2);
+        REQUIRE(result);
+        REQUIRE(result->index() == 1);
+        REQUIRE(std::get<1>(*result) == "hello");
+    }
+
+    SECTION("fairness") {
+        for (int i{0}; i < 4; ++i) {
+            REQUIRE(sender1.trySend(i));
+            REQUIRE(sender2.trySend(std::to_string(i)));
+        }
+
+        std::array<std::size_t, 2> counts{};
+
+        for (int i{0}; i < 4; ++i) {
+            const auto result = zero::concurrent::select(receiver1, receiver2);
+            REQUIRE(result);
+            ++counts[result->index()];
+        }
+
+        REQUIRE(counts[0] == 2);
+        REQUIRE(counts[1] == 2);
+    }
+
+    SECTION("wait") {
+        auto future = std::async([&] {
+            return zero::concurrent::select(receiver1, receiver2);
+        });
+
+        std::this_thread::sleep_for(10ms);
+        REQUIRE(sender1.send(42));
+
+        const auto result = future.get();
+        REQUIRE(result);
+        REQUIRE(result->index() == 0);
+        REQUIRE(std::get<0>(*result) == 42);
+    }
+
+    SECTION("timeout") {
+        REQUIRE_ERROR(zero::concurrent::select(10ms, receiver1, receiver2), zero::concurrent::ReceiveError::Timeout);
+    }
+
+    SECTION("disconnected") {
+        sender1.close();
+
+        auto future = std::async([&] {
+            return zero::concurrent::select(receiver1, receiver2);
+        });
+
+        std::this_thread::sleep_for(10ms);
+        REQUIRE(sender2.send("world"));
+
+        const auto result = future.get();
+        REQUIRE(result);
+        REQUIRE(std::get<1>(*result) == "world");
+
+        sender2.close();
+        REQUIRE_ERROR(zero::concurrent::select(receiver1, receiver2), zero::concurrent::ReceiveError::Disconnected);
+    }
+}
+
+TEST_CASE("channel select concurrency testing", "[concurrent::channel]") {
+    const auto capacity = GENERATE(take(3, random(1uz, 1024uz)));
+    const auto times = GENERATE(take(3, random(1uz, 102400uz)));
+
+    auto [sender1, receiver1] = zero::concurrent::channel<std::size_t>(capacity);
+    auto [sender2, receiver2] = zero::concurrent::channel<std::size_t>(capacity);
+
+    const auto produce = [&](auto &sender) {
+        for (std::size_t i{0}; i < times; ++i)
+            zero::error::guard(sender.send(i));
+
+        sender.close();
+    };
+
+    auto producer1 = std::async([&] {
+        produce(sender1);
+    });
+
+    auto producer2 = std::async([&] {
+        produce(sender2);
+    });
+
+    std::array<std::size_t, 2> sums{};
+
+    while (true) {
+        const auto result = zero::concurrent::select(receiver1, receiver2);
+
+        if (!result) {
+            REQUIRE(result.error() == zero::concurrent::ReceiveError::Disconnected);
+            break;
+        }
+
+        std::visit(
+            [&](const std::size_t value) {
+                sums[result->index()] += value;
+            },
+            *result
+        );
+    }
+
+    REQUIRE_NOTHROW(producer1.get());
+    REQUIRE_NOTHROW(producer2.get());
+    REQUIRE(sums[0] == times * (times - 1) / 2);
+    REQUIRE(sums[1] == times * (times - 1) / 2);
+}
+
+TEST_CASE("channel async", "[concurrent::channel]") {
+    using namespace std::chrono_literals;
+
+    auto [sender, receiver] = zero::concurrent::channel<int>(2);
+
+    SECTION("send") {
+        SECTION("no wait") {
+            auto future = sender.sendAsync(1);
+            REQUIRE(future.isReady());
+            REQUIRE(std::move(future).get());
+            REQUIRE(receiver.tryReceive() == 1);
+        }
+
+        SECTION("wait") {
+            REQUIRE(sender.trySend(1));
+            REQUIRE(sender.trySend(2));
+
+            auto future = sender.sendAsync(3);
+            REQUIRE_FALSE(future.isReady());
+
+            REQUIRE(receiver.tryReceive() == 1);
+            REQUIRE(future.isReady());
+            REQUIRE(std::move(future).get());
+
+            REQUIRE(receiver.tryReceive() == 2);
+            REQUIRE(receiver.tryReceive() == 3);
+        }
+
+        SECTION("disconnected") {
+            REQUIRE(sender.trySend(1));
+            REQUIRE(sender.trySend(2));
+
+            auto future = sender.sendAsync(3);
+            REQUIRE_FALSE(future.isReady());
+
+            sender.close();
+            REQUIRE_ERROR(std::move(future).get(), zero::concurrent::SendError::Disconnected);
+            REQUIRE_ERROR(sender.sendAsync(4).get(), zero::concurrent::SendError::Disconnected);
+        }
+
+        SECTION("timeout") {
+            REQUIRE(sender.trySend(1));
+            REQUIRE(sender.trySend(2));
+
+            const auto result = sender.sendAsync(3).timeout(10ms).get();
+            REQUIRE_ERROR(result, zero::async::promise::TimeoutError::Elapsed);
+
+            REQUIRE(receiver.tryReceive() == 1);
+            REQUIRE(receiver.tryReceive() == 2);
+            REQUIRE_ERROR(receiver.tryReceive(), zero::concurrent::TryReceiveError::Empty);
+        }
+
+        SECTION("cancel") {
+            REQUIRE(sender.trySend(1));
+            REQUIRE(sender.trySend(2));
+
+            zero::async::CancellationSource source;
+            auto future = sender.sendAsync(3, source.token());
+
+            REQUIRE(source.cancel());
+            REQUIRE_ERROR(std::move(future).get(), std::errc::operation_canceled);
+        }
+    }
+
+    SECTION("receive") {
+        SECTION("no wait") {
+            REQUIRE(sender.trySend(1));
+            REQUIRE(receiver.receiveAsync().get() == 1);
+        }
+
+        SECTION("wait") {
+            auto future = receiver.receiveAsync();
+            REQUIRE_FALSE(future.isReady());
+
+            REQUIRE(sender.trySend(1));
+            REQUIRE(future.isReady());
+            REQUIRE(std::move(future).get() == 1);
+            REQUIRE(sender.empty());
+        }
+
+        SECTION("order") {
+            auto future1 = receiver.receiveAsync();
+            auto future2 = receiver.receiveAsync();
+
+            REQUIRE(sender.trySend(1));
+            REQUIRE(sender.trySend(2));
+
+            REQUIRE(std::move(future1).get() == 1);
+            REQUIRE(std::move(future2).get() == 2);
+        }
+
+        SECTION("from async sender") {
+            REQUIRE(sender.trySend(1));
+            REQUIRE(sender.trySend(2));
+
+            auto future = sender.sendAsync(3);
+            REQUIRE_FALSE(future.isReady());
+
+            REQUIRE(receiver.receiveAsync().get() == 1);
+            REQUIRE(std::move(future).get());
+            REQUIRE(receiver.receiveAsync().get() == 2);
+            REQUIRE(receiver.receiveAsync().get() == 3);
+        }
+
+        SECTION("disconnected") {
+            auto future = receiver.receiveAsync();
+            REQUIRE_FALSE(future.isReady());
+
+            sender.close();
+            REQUIRE_ERROR(std::move(future).get(), zero::concurrent::ReceiveError::Disconnected);
+            REQUIRE_ERROR(receiver.receiveAsync().get(), zero::concurrent::ReceiveError::Disconnected);
+        }
+
+        SECTION("timeout") {
+            const auto result = receiver.receiveAsync().timeout(10ms).get();
+            REQUIRE_ERROR(result, zero::async::promise::TimeoutError::Elapsed);
+
+            // the withdrawn request must not swallow the next element
+            REQUIRE(sender.trySend(1));
+            REQUIRE(receiver.tryReceive() == 1);
+        }
+
+        SECTION("cancel") {
+            auto future = receiver.receiveAsync();
+
+            REQUIRE(future.cancel());
+            REQUIRE_ERROR(std::move(future).get(), std::errc::operation_canceled);
+        }
+    }
+}
+
+TEST_CASE("channel async concurrency testing", "[concurrent::channel]") {
+    const auto capacity = GENERATE(take(3, random(1uz, 1024uz)));
+    const auto times = GENERATE(take(3, random(1uz, 102400uz)));
+
+    auto [sender, receiver] = zero::concurrent::channel<std::size_t>(capacity);
+
+    auto producer = std::async([&] {
+        for (std::size_t i{0}; i < times; ++i)
+            zero::error::guard(sender.sendAsync(i).get());
+
+        sender.close();
+    });
+
+    std::size_t sum{0};
+
+    while (true) {
+        auto result = receiver.receiveAsync().get();
+
+        if (!result) {
+            REQUIRE(result.error() == zero::concurrent::ReceiveError::Disconnected);
+            break;
+        }
+
+        sum += *result;
+    }
+
+    REQUIRE_NOTHROW(producer.get());
+    REQUIRE(sum == times * (times - 1) / 2);
+}
+
+TEST_CASE("channel stats", "[concurrent::channel]") {
+    using namespace std::chrono_literals;
+
+    SECTION("transfer") {
+        auto [sender, receiver] = zero::concurrent::channel<int, zero::concurrent::ChannelStats>(4);
+
+        REQUIRE(sender.trySend(1));
+        REQUIRE(sender.send(2));
+        REQUIRE(sender.trySendMany(std::array{3, 4}) == 2);
+        REQUIRE(receiver.tryReceive() == 1);
+
+        std::vector<int> elements;
+        REQUIRE(receiver.tryReceiveMany(std::back_inserter(elements), 2) == 2);
+
+        const auto stats = sender.stats();
+        REQUIRE(stats.highWaterMark == 4);
+        REQUIRE(stats.sent == 4);
+        REQUIRE(stats.received == 3);
+        REQUIRE(stats.senderParks == 0);
+        REQUIRE(stats.receiverParks == 0);
+    }
+
+    SECTION("park") {
+        auto [sender, receiver] = zero::concurrent::channel<int, zero::concurrent::ChannelStats>(1);
+
+        REQUIRE_ERROR(receiver.receive(10ms), zero::concurrent::ReceiveError::Timeout);
+        REQUIRE(sender.trySend(1));
+        REQUIRE_ERROR(sender.send(2, 10ms), zero::concurrent::SendError::Timeout);
+
+        const auto stats = receiver.stats();
+        REQUIRE(stats.receiverParks == 1);
+        REQUIRE(stats.receiverParkTime >= 10ms);
+        REQUIRE(stats.senderParks == 1);
+        REQUIRE(stats.senderParkTime >= 10ms);
+    }
+
+    SECTION("unbounded") {
+        auto [sender, receiver] = zero::concurrent::unboundedChannel<int, zero::concurrent::ChannelStats>();
+
+        for (int i{0}; i < 100; ++i)
+            REQUIRE(sender.trySend(i));
+
+        for (int i{0}; i < 100; ++i)
+            REQUIRE(receiver.tryReceive() == i);
+
+        const auto stats = receiver.stats();
+        REQUIRE(stats.highWaterMark == 100);
+        REQUIRE(stats.sent == 100);
+        REQUIRE(stats.received == 100);
+        REQUIRE(stats.sendRetries == 0);
+        REQUIRE(stats.receiveRetries == 0);
+    }
+}
+
+TEST_CASE("channel stats concurrency testing", "[concurrent::channel]") {
+    const auto capacity = GENERATE(take(3, random(1uz, 1024uz)));
+    const auto times = GENERATE(take(3, random(1uz, 102400uz)));
+
+    auto [sender, receiver] = zero::concurrent::channel<std::size_t, zero::concurrent::ChannelStats>(capacity);
+
+    std::vector<std::future<void>> producers;
+
+    for (int i{0}; i < 2; ++i)
+        producers.push_back(std::async([&, sender = sender] mutable {
+            for (std::size_t j{0}; j < times; ++j)
+                zero::error::guard(sender.send(j));
+        }));
+
+    std::vector<std::future<void>> consumers;
+
+    for (int i{0}; i < 2; ++i)
+        consumers.push_back(std::async([&, receiver = receiver] mutable {
+            while (receiver.receive()) {
+            }
+        }));
+
+    for (auto &producer: producers)
+        REQUIRE_NOTHROW(producer.get());
+
+    sender.close();
+
+    for (auto &consumer: consumers)
+        REQUIRE_NOTHROW(consumer.get());
+
+    const auto stats = receiver.stats();
+    REQUIRE(stats.sent == times * 2);
+    REQUIRE(stats.received == times * 2);
+    REQUIRE(stats.highWaterMark <= capacity);
+}
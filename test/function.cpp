@@ -0,0 +1,84 @@
+#include "catch_extensions.h"
+#include <zero/function.h>
+#include <memory>
+#include <array>
+
+TEST_CASE("small function", "[function]") {
+    SECTION("empty") {
+        zero::SmallFunction<int()> function;
+        REQUIRE_FALSE(function);
+
+        function = [] {
+            return 1;
+        };
+        REQUIRE(function);
+
+        function = nullptr;
+        REQUIRE_FALSE(function);
+    }
+
+    SECTION("empty function pointer") {
+        int (*ptr)() = nullptr;
+        const zero::SmallFunction<int()> function{ptr};
+        REQUIRE_FALSE(function);
+    }
+
+    SECTION("invoke") {
+        zero::SmallFunction<int(int, int)> function{
+            [](const int lhs, const int rhs) {
+                return lhs + rhs;
+            }
+        };
+        REQUIRE(function(1, 2) == 3);
+    }
+
+    SECTION("move only") {
+        zero::SmallFunction<int(int)> function{
+            [ptr = std::make_unique<int>(1)](const int value) {
+                return *ptr + value;
+            }
+        };
+        REQUIRE(function(1) == 2);
+
+        auto other = std::move(function);
+        REQUIRE_FALSE(function);
+        REQUIRE(other(2) == 3);
+    }
+
+    SECTION("large callable") {
+        const auto counter = std::make_shared<int>(0);
+
+        {
+            zero::SmallFunction<int()> function{
+                [counter, array = std::array<int, 64>{1}] {
+                    return ++*counter + array[0];
+                }
+            };
+            REQUIRE(counter.use_count() == 2);
+            REQUIRE(function() == 2);
+
+            auto other = std::move(function);
+            REQUIRE(other() == 3);
+        }
+
+        REQUIRE(counter.use_count() == 1);
+    }
+
+    SECTION("destroy") {
+        const auto counter = std::make_shared<int>(0);
+
+        {
+            zero::SmallFunction<void()> function{
+                [counter] {
+                }
+            };
+            REQUIRE(counter.use_count() == 2);
+
+            function = [] {
+            };
+            REQUIRE(counter.use_count() == 1);
+        }
+
+        REQUIRE(counter.use_count() == 1);
+    }
+}
@@ -8,6 +8,17 @@
 #include <fakeit.hpp>
 #include <ranges>
 
+namespace {
+    // The logger hands sinks batches of records, which the mocks verify one by one.
+    void forwardBatches(fakeit::Mock<zero::log::ISink> &mock) {
+        fakeit::When(Method(mock, writeBatch))
+            .AlwaysDo([&](const auto records) {
+                for (const auto &record: records)
+                    mock.get().write(record);
+            });
+    }
+}
+
 TEST_CASE("logger", "[log]") {
     constexpr std::array levels{
         zero::log::Level::Debug,
@@ -25,8 +36,9 @@ TEST_CASE("logger", "[log]") {
     fakeit::Mock<zero::log::ISink> mock;
 
     fakeit::Fake(Dtor(mock));
+    forwardBatches(mock);
     fakeit::When(
-        Method(mock, write)
+        OverloadedMethod(mock, write, void(const zero::log::Record &))
         .Matching([&](const auto &record) {
             return record.level <= level &&
                 record.line == line &&
@@ -63,7 +75,7 @@ TEST_CASE("logger", "[log]") {
             zero::error::guard(event.wait());
             REQUIRE(std::chrono::system_clock::now() - tp > interval - 5ms);
 
-            fakeit::Verify(Method(mock, write)).Once();
+            fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Once();
             fakeit::Verify(Method(mock, flush)).AtLeastOnce();
         }
 
@@ -91,7 +103,7 @@ TEST_CASE("logger", "[log]") {
 
             logger.sync();
 
-            fakeit::Verify(Method(mock, write)).Never();
+            fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Never();
         }
 
         SECTION("non-existent") {
@@ -121,7 +133,7 @@ TEST_CASE("logger", "[log]") {
             logger.sync();
 
             const auto times = std::to_underlying(level) - std::to_underlying(zero::log::Level::Error) + 1;
-            fakeit::Verify(Method(mock, write)).Exactly(times);
+            fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Exactly(times);
         }
 
         SECTION("non-existent") {
@@ -146,7 +158,7 @@ TEST_CASE("logger", "[log]") {
             zero::error::guard(event.wait());
             REQUIRE(std::chrono::system_clock::now() - tp > interval - 5ms);
 
-            fakeit::Verify(Method(mock, write)).Once();
+            fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Once();
             fakeit::Verify(Method(mock, flush)).AtLeastOnce();
         }
 
@@ -203,6 +215,17 @@ TEST_CASE("logger", "[log]") {
                     }
                 }
             }
+
+            SECTION("after the sinks change") {
+                logger.add(level, std::unique_ptr<zero::log::ISink>{&mock.get()}, "sink", {tag});
+                logger.setLevel("sink", zero::log::Level::Error);
+
+                REQUIRE(logger.enabled(zero::log::Level::Error, tag));
+                REQUIRE_FALSE(logger.enabled(zero::log::Level::Warning, tag));
+
+                logger.remove("sink");
+                REQUIRE_FALSE(logger.enabled(zero::log::Level::Error, tag));
+            }
         }
     }
 
@@ -217,7 +240,7 @@ TEST_CASE("logger", "[log]") {
                 logger.sync();
 
                 const auto times = std::to_underlying(level) - std::to_underlying(zero::log::Level::Error) + 1;
-                fakeit::Verify(Method(mock, write)).Exactly(times);
+                fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Exactly(times);
             }
 
             SECTION("with tagged sink") {
@@ -229,7 +252,7 @@ TEST_CASE("logger", "[log]") {
                     logger.log(lv, filename, line, content);
 
                 logger.sync();
-                fakeit::Verify(Method(mock, write)).Never();
+                fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Never();
             }
         }
 
@@ -245,7 +268,7 @@ TEST_CASE("logger", "[log]") {
                 logger.sync();
 
                 const auto times = std::to_underlying(level) - std::to_underlying(zero::log::Level::Error) + 1;
-                fakeit::Verify(Method(mock, write)).Exactly(times);
+                fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Exactly(times);
             }
 
             SECTION("without matched tag") {
@@ -262,7 +285,7 @@ TEST_CASE("logger", "[log]") {
                     logger.log(lv, filename, line, content, tag);
 
                 logger.sync();
-                fakeit::Verify(Method(mock, write)).Never();
+                fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Never();
             }
         }
     }
@@ -277,11 +300,91 @@ TEST_CASE("logger", "[log]") {
 
         logger.sync();
 
-        fakeit::Verify(Method(mock, write)).Exactly(times);
+        fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Exactly(times);
         fakeit::Verify(Method(mock, flush)).AtLeastOnce();
     }
 }
 
+TEST_CASE("logger concurrency testing", "[log]") {
+    const auto threads = GENERATE(take(1, random(2, 16)));
+    const auto times = GENERATE(take(1, random(1, 10240)));
+
+    fakeit::Mock<zero::log::ISink> mock;
+
+    fakeit::Fake(Dtor(mock));
+    forwardBatches(mock);
+    fakeit::When(OverloadedMethod(mock, write, void(const zero::log::Record &))).AlwaysReturn();
+    fakeit::When(Method(mock, flush)).AlwaysReturn();
+
+    zero::log::Logger logger;
+    logger.add(zero::log::Level::Info, std::unique_ptr<zero::log::ISink>{&mock.get()});
+
+    std::vector<std::thread> producers;
+
+    for (int i{0}; i < threads; ++i)
+        producers.emplace_back([&] {
+            for (int j{0}; j < times; ++j)
+                logger.log(zero::log::Level::Info, "a", j, zero::log::makeMessage("{}", j));
+        });
+
+    for (auto &producer: producers)
+        producer.join();
+
+    logger.sync();
+    fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Exactly(threads * times);
+}
+
+TEST_CASE("tag levels under concurrent changes", "[log]") {
+    class NullSink final : public zero::log::ISink {
+    public:
+        void write(const zero::log::Record &) override {
+        }
+
+        void flush() override {
+        }
+    };
+
+    const auto threads = GENERATE(take(1, random(2, 16)));
+    const auto times = GENERATE(take(1, random(1000, 10240)));
+
+    zero::log::Logger logger;
+    logger.add(zero::log::Level::Error, std::make_unique<NullSink>(), "fixed", {"net"});
+    logger.add(zero::log::Level::Info, std::make_unique<NullSink>(), "changing", {"net", "db"});
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> violations{0};
+    std::vector<std::thread> readers;
+
+    for (int i{0}; i < threads; ++i)
+        readers.emplace_back([&] {
+            while (!stop) {
+                // whatever level the changing sink is at, it accepts info tagged `db`, and no sink accepts `none`
+                if (!logger.enabled(zero::log::Level::Error, "net") ||
+                    !logger.enabled(zero::log::Level::Info, "db") ||
+                    logger.enabled(zero::log::Level::Error, "none"))
+                    ++violations;
+            }
+        });
+
+    for (int i{0}; i < times; ++i) {
+        logger.setLevel("changing", i % 2 ? zero::log::Level::Debug : zero::log::Level::Info);
+
+        if (i % 3 == 0) {
+            logger.add(zero::log::Level::Debug, std::make_unique<NullSink>(), "transient", {"db", "cache"});
+            logger.remove("transient");
+        }
+    }
+
+    stop = true;
+
+    for (auto &reader: readers)
+        reader.join();
+
+    REQUIRE(violations == 0);
+    REQUIRE(logger.enabled(zero::log::Level::Info, "db"));
+    REQUIRE_FALSE(logger.enabled(zero::log::Level::Debug, "cache"));
+}
+
 TEST_CASE("override log level from environment variable", "[log]") {
     constexpr std::array levels{
         zero::log::Level::Debug,
@@ -304,7 +407,8 @@ TEST_CASE("override log level from environment variable", "[log]") {
     fakeit::Mock<zero::log::ISink> mock;
 
     fakeit::Fake(Dtor(mock));
-    fakeit::When(Method(mock, write)).AlwaysReturn();
+    forwardBatches(mock);
+    fakeit::When(OverloadedMethod(mock, write, void(const zero::log::Record &))).AlwaysReturn();
     fakeit::When(Method(mock, flush)).AlwaysReturn();
 
     zero::log::Logger logger;
@@ -326,7 +430,229 @@ TEST_CASE("override log level from environment variable", "[log]") {
     logger.sync();
 
     const auto times = std::to_underlying(level) - std::to_underlying(zero::log::Level::Error) + 1;
-    fakeit::Verify(Method(mock, write)).Exactly(times);
+    fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Exactly(times);
+}
+
+TEST_CASE("deferred log message", "[log]") {
+    SECTION("make message") {
+        static_assert(std::same_as<decltype(zero::log::makeMessage("{} {}", 1, 2.5)), zero::log::DeferredMessage>);
+        static_assert(std::same_as<decltype(zero::log::makeMessage("{}", std::string{})), std::string>);
+        static_assert(std::same_as<decltype(zero::log::makeMessage("{}", "literal")), std::string>);
+        static_assert(std::same_as<decltype(zero::log::makeMessage(fmt::runtime("{}"), 1)), std::string>);
+
+        REQUIRE(zero::log::makeMessage("{} {:.1f} {}", 1, 2.5, true).format() == "1 2.5 true");
+        REQUIRE(zero::log::makeMessage("{}", std::chrono::milliseconds{10}).format() == "10ms");
+        REQUIRE(zero::log::makeMessage("{{}}").format() == "{}");
+    }
+
+    SECTION("format on logger thread") {
+        fakeit::Mock<zero::log::ISink> mock;
+
+        fakeit::Fake(Dtor(mock));
+        forwardBatches(mock);
+        fakeit::When(OverloadedMethod(mock, write, void(const zero::log::Record &))).AlwaysReturn();
+        fakeit::When(Method(mock, flush)).AlwaysReturn();
+
+        zero::log::Logger logger;
+        logger.add(zero::log::Level::Info, std::unique_ptr<zero::log::ISink>{&mock.get()});
+
+        logger.log(zero::log::Level::Info, "a", 1, zero::log::makeMessage("value: {}", 42));
+        logger.log(zero::log::Level::Debug, "a", 1, zero::log::makeMessage("value: {}", 43));
+        logger.sync();
+
+        fakeit::Verify(
+            OverloadedMethod(mock, write, void(const zero::log::Record &)).Matching([](const auto &record) {
+                return record.content == "value: 42";
+            })
+        ).Once();
+        fakeit::Verify(OverloadedMethod(mock, write, void(const zero::log::Record &))).Once();
+    }
+
+    SECTION("runtime format string") {
+        fakeit::Mock<zero::log::ISink> mock;
+
+        fakeit::Fake(Dtor(mock));
+        forwardBatches(mock);
+        fakeit::When(OverloadedMethod(mock, write, void(const zero::log::Record &))).AlwaysReturn();
+        fakeit::When(Method(mock, flush)).AlwaysReturn();
+
+        zero::log::Logger logger;
+        logger.add(zero::log::Level::Info, std::unique_ptr<zero::log::ISink>{&mock.get()});
+
+        {
+            // destroyed before the logger thread gets to the record
+            auto format = std::make_unique<std::string>("value: {}");
+            logger.log(zero::log::Level::Info, "a", 1, zero::log::makeMessage(fmt::runtime(*format), 42));
+        }
+
+        logger.sync();
+
+        fakeit::Verify(
+            OverloadedMethod(mock, write, void(const zero::log::Record &)).Matching([](const auto &record) {
+                return record.content == "value: 42";
+            })
+        ).Once();
+    }
+}
+
+TEST_CASE("log overflow and sampling", "[log]") {
+    zero::atomic::Event entered;
+    zero::atomic::Event proceed;
+    std::vector<int> lines;
+
+    fakeit::Mock<zero::log::ISink> mock;
+
+    fakeit::Fake(Dtor(mock));
+    forwardBatches(mock);
+    fakeit::When(OverloadedMethod(mock, write, void(const zero::log::Record &))).AlwaysDo([&](const auto &record) {
+        if (record.line < 0) {
+            entered.set();
+            REQUIRE(proceed.wait());
+            return;
+        }
+
+        lines.push_back(record.line);
+    });
+    fakeit::When(Method(mock, flush)).AlwaysReturn();
+
+    zero::log::Logger logger;
+    logger.add(zero::log::Level::Info, std::unique_ptr<zero::log::ISink>{&mock.get()});
+
+    SECTION("overflow") {
+        // keeps the logger thread busy with the first record, while the ring of this thread fills up
+        logger.log(zero::log::Level::Info, "a", -1, "");
+        REQUIRE(entered.wait());
+
+        SECTION("drop newest") {
+            logger.setOverflowPolicy(zero::log::OverflowPolicy::DropNewest);
+
+            for (int i{0}; i < 300; ++i)
+                logger.log(zero::log::Level::Info, "a", i, "");
+
+            proceed.set();
+            logger.sync();
+
+            REQUIRE(logger.dropped().overflowed == 44);
+            REQUIRE(lines == (std::views::iota(0, 256) | std::ranges::to<std::vector>()));
+        }
+
+        SECTION("drop oldest") {
+            logger.setOverflowPolicy(zero::log::OverflowPolicy::DropOldest);
+
+            for (int i{0}; i < 300; ++i)
+                logger.log(zero::log::Level::Info, "a", i, "");
+
+            proceed.set();
+            logger.sync();
+
+            REQUIRE(logger.dropped().overflowed == 44);
+            REQUIRE(lines == (std::views::iota(44, 300) | std::ranges::to<std::vector>()));
+        }
+    }
+
+    SECTION("sampling") {
+        SECTION("by level") {
+            logger.setRateLimit(zero::log::Level::Info, 10);
+
+            for (int i{0}; i < 100; ++i)
+                logger.log(zero::log::Level::Info, "a", i, "");
+
+            logger.sync();
+
+            // the records may straddle two seconds
+            REQUIRE(lines.size() >= 10);
+            REQUIRE(lines.size() <= 20);
+            REQUIRE(logger.dropped().sampled == 100 - lines.size());
+        }
+
+        SECTION("by tag") {
+            logger.setRateLimit("a", 10);
+
+            for (int i{0}; i < 100; ++i) {
+                logger.log(zero::log::Level::Info, "a", i, "", "a");
+                logger.log(zero::log::Level::Info, "a", i, "", "b");
+            }
+
+            logger.sync();
+
+            REQUIRE(logger.dropped().sampled >= 80);
+            REQUIRE(logger.dropped().sampled <= 90);
+        }
+
+        SECTION("change by tag") {
+            logger.setRateLimit("a", 0);
+            logger.log(zero::log::Level::Info, "a", 0, "", "a");
+
+            // adding a tag carries the limits of the others over
+            logger.setRateLimit("b", 0);
+            logger.log(zero::log::Level::Info, "a", 1, "", "a");
+
+            logger.setRateLimit("a", std::nullopt);
+            logger.log(zero::log::Level::Info, "a", 2, "", "a");
+            logger.log(zero::log::Level::Info, "a", 3, "", "b");
+            logger.sync();
+
+            REQUIRE(logger.dropped().sampled == 3);
+        }
+
+        SECTION("one in n by level") {
+            logger.setSampleRate(zero::log::Level::Info, 4);
+
+            for (int i{0}; i < 100; ++i)
+                logger.log(zero::log::Level::Info, "a", i, "");
+
+            logger.setSampleRate(zero::log::Level::Info, std::nullopt);
+            logger.log(zero::log::Level::Info, "a", 100, "");
+            logger.sync();
+
+            auto expected = std::views::iota(0, 25)
+                | std::views::transform([](const auto i) { return i * 4; })
+                | std::ranges::to<std::vector>();
+
+            expected.push_back(100);
+
+            REQUIRE(lines == expected);
+            REQUIRE(logger.dropped().sampled == 75);
+        }
+
+        SECTION("one in n by tag") {
+            logger.setSampleRate("a", 10);
+
+            for (int i{0}; i < 100; ++i) {
+                logger.log(zero::log::Level::Info, "a", i, "", "a");
+                logger.log(zero::log::Level::Info, "a", i, "", "b");
+            }
+
+            logger.sync();
+
+            REQUIRE(logger.dropped().sampled == 90);
+        }
+
+        SECTION("one in n before the rate") {
+            // the rate only counts the records sampling kept
+            logger.setSampleRate(zero::log::Level::Info, 2);
+            logger.setRateLimit(zero::log::Level::Info, 1000);
+
+            for (int i{0}; i < 100; ++i)
+                logger.log(zero::log::Level::Info, "a", i, "");
+
+            logger.sync();
+
+            REQUIRE(lines.size() == 50);
+            REQUIRE(logger.dropped().sampled == 50);
+        }
+
+        SECTION("lift") {
+            logger.setRateLimit(zero::log::Level::Info, 0);
+            logger.log(zero::log::Level::Info, "a", 0, "");
+            logger.setRateLimit(zero::log::Level::Info, std::nullopt);
+            logger.log(zero::log::Level::Info, "a", 1, "");
+            logger.sync();
+
+            REQUIRE(lines == std::vector{1});
+            REQUIRE(logger.dropped().sampled == 1);
+        }
+    }
 }
 
 TEST_CASE("file log sink", "[log]") {
@@ -375,6 +701,63 @@ TEST_CASE("file log sink", "[log]") {
         );
     }
 
+    SECTION("batch write") {
+        zero::error::guard(zero::filesystem::createDirectory(directory));
+        Z_DEFER(zero::error::guard(zero::filesystem::removeAll(directory)));
+
+        zero::log::FileSink sink{name, directory};
+
+        const std::array records{
+            zero::log::Record{.line = 1, .content = "a"},
+            zero::log::Record{.line = 2, .content = "b"},
+            zero::log::Record{.line = 3, .content = "c"}
+        };
+
+        REQUIRE_NOTHROW(sink.writeBatch(records));
+        REQUIRE_NOTHROW(sink.flush());
+
+        std::list<std::filesystem::path> files;
+
+        auto iterator = zero::error::guard(zero::filesystem::readDirectory(directory));
+
+        while (const auto entry = zero::error::guard(iterator.next()))
+            files.push_back(entry->path());
+
+        REQUIRE_THAT(files, Catch::Matchers::SizeIs(1));
+
+        const auto content = zero::error::guard(zero::filesystem::readString(files.front()));
+
+        for (const auto &record: records)
+            REQUIRE_THAT(content, Catch::Matchers::ContainsSubstring(fmt::to_string(record)));
+    }
+
+    SECTION("derived batch write") {
+        zero::error::guard(zero::filesystem::createDirectory(directory));
+        Z_DEFER(zero::error::guard(zero::filesystem::removeAll(directory)));
+
+        class CountingSink final : public zero::log::FileSink {
+        public:
+            using FileSink::FileSink;
+
+            void write(const zero::log::Record &record) override {
+                lines.push_back(record.line);
+                FileSink::write(record);
+            }
+
+            std::vector<int> lines;
+        };
+
+        CountingSink sink{name, directory};
+
+        const std::array records{
+            zero::log::Record{.line = 1, .content = "a"},
+            zero::log::Record{.line = 2, .content = "b"}
+        };
+
+        REQUIRE_NOTHROW(sink.writeBatch(records));
+        REQUIRE(sink.lines == std::vector{1, 2});
+    }
+
     SECTION("rotate") {
         using namespace std::chrono_literals;
 